@@ -0,0 +1,231 @@
+#ifndef BALANCEDBST_H
+#define BALANCEDBST_H
+
+#include "Book.h"
+#include <QString>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * @brief Self-balancing (AVL) binary search tree of books keyed by text
+ *
+ * Nodes live in one contiguous arena (std::vector) and link to each other
+ * by index, so building the tree is a handful of large allocations and
+ * traversals touch no reference counts. Insert, search and in-order
+ * traversal are all iterative; the AVL invariant keeps the height below
+ * 1.44 log2(n), even when keys arrive already sorted.
+ *
+ * Duplicate keys are ignored (the first book inserted with a key wins).
+ * Pointers returned by find() stay valid until the next insert or clear.
+ */
+class BalancedBST
+{
+public:
+    BalancedBST() : m_root(kNull) {}
+
+    /**
+     * @brief Insert a book under a key - O(log n)
+     * @param key Search key (e.g. lowercased title)
+     * @param book Book stored in the node
+     * @return true if inserted, false if the key already exists
+     */
+    bool insert(const QString& key, const Book& book)
+    {
+        int32_t path[kMaxHeight];
+        bool wentLeft[kMaxHeight];
+        int depth = 0;
+
+        // Walk down, remembering the path for the rebalancing pass
+        for (int32_t cur = m_root; cur != kNull; ) {
+            int cmp = QString::compare(key, m_nodes[cur].key);
+            if (cmp == 0) return false;
+            path[depth] = cur;
+            wentLeft[depth] = cmp < 0;
+            depth++;
+            cur = cmp < 0 ? m_nodes[cur].left : m_nodes[cur].right;
+        }
+
+        m_nodes.push_back(Node(key, book));
+        int32_t child = static_cast<int32_t>(m_nodes.size() - 1);
+
+        // Walk back up: relink, update heights and rotate where needed
+        while (depth > 0) {
+            depth--;
+            int32_t parent = path[depth];
+            if (wentLeft[depth]) m_nodes[parent].left = child;
+            else m_nodes[parent].right = child;
+            child = rebalance(parent);
+        }
+        m_root = child;
+        return true;
+    }
+
+    /**
+     * @brief Replace the tree with a perfectly balanced one built from sorted input - O(n)
+     * Item i becomes arena node i and every subtree root is the middle of
+     * its range, so no comparisons or rotations are needed.
+     * @param count Number of items
+     * @param keyAt Callback returning the key of item i (strictly increasing in i)
+     * @param bookAt Callback returning the book of item i
+     */
+    template<typename KeyAt, typename BookAt>
+    void assignSorted(size_t count, KeyAt keyAt, BookAt bookAt)
+    {
+        clear();
+        m_nodes.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            m_nodes.push_back(Node(keyAt(i), bookAt(i)));
+        }
+        m_root = linkRange(0, static_cast<int32_t>(count) - 1);
+    }
+
+    /**
+     * @brief Find the book stored under a key - O(log n)
+     * @param key Exact key to look up
+     * @return Pointer to the stored book, nullptr if not found
+     */
+    Book* find(const QString& key)
+    {
+        int32_t cur = m_root;
+        while (cur != kNull) {
+            int cmp = QString::compare(key, m_nodes[cur].key);
+            if (cmp == 0) return &m_nodes[cur].book;
+            cur = cmp < 0 ? m_nodes[cur].left : m_nodes[cur].right;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Visit every node in key order (iterative in-order traversal)
+     * @param visit Callback taking (const QString& key, const Book& book)
+     */
+    template<typename Visitor>
+    void inOrder(Visitor visit) const
+    {
+        int32_t stack[kMaxHeight];
+        int top = 0;
+        int32_t cur = m_root;
+
+        while (cur != kNull || top > 0) {
+            while (cur != kNull) {
+                stack[top++] = cur;
+                cur = m_nodes[cur].left;
+            }
+            cur = stack[--top];
+            visit(m_nodes[cur].key, m_nodes[cur].book);
+            cur = m_nodes[cur].right;
+        }
+    }
+
+    /**
+     * @brief Remove all nodes (keeps the arena capacity)
+     */
+    void clear()
+    {
+        m_nodes.clear();
+        m_root = kNull;
+    }
+
+    /**
+     * @brief Reserve arena space for count nodes
+     */
+    void reserve(size_t count) { m_nodes.reserve(count); }
+
+    size_t size() const { return m_nodes.size(); }
+    bool empty() const { return m_root == kNull; }
+
+    /**
+     * @brief Height of the tree (0 when empty)
+     */
+    int height() const { return heightOf(m_root); }
+
+private:
+    static constexpr int32_t kNull = -1;
+    static constexpr int kMaxHeight = 64;  ///< AVL height for 2^32 nodes is below 47
+
+    struct Node {
+        QString key;
+        Book book;
+        int32_t left;
+        int32_t right;
+        int32_t height;
+
+        Node(const QString& k, const Book& b) : key(k), book(b), left(kNull), right(kNull), height(1) {}
+    };
+
+    std::vector<Node> m_nodes;  ///< Node arena
+    int32_t m_root;             ///< Index of the root node (kNull when empty)
+
+    int heightOf(int32_t node) const { return node == kNull ? 0 : m_nodes[node].height; }
+
+    void updateHeight(int32_t node)
+    {
+        m_nodes[node].height = 1 + std::max(heightOf(m_nodes[node].left), heightOf(m_nodes[node].right));
+    }
+
+    int balanceOf(int32_t node) const
+    {
+        return heightOf(m_nodes[node].left) - heightOf(m_nodes[node].right);
+    }
+
+    int32_t rotateRight(int32_t node)
+    {
+        int32_t pivot = m_nodes[node].left;
+        m_nodes[node].left = m_nodes[pivot].right;
+        m_nodes[pivot].right = node;
+        updateHeight(node);
+        updateHeight(pivot);
+        return pivot;
+    }
+
+    int32_t rotateLeft(int32_t node)
+    {
+        int32_t pivot = m_nodes[node].right;
+        m_nodes[node].right = m_nodes[pivot].left;
+        m_nodes[pivot].left = node;
+        updateHeight(node);
+        updateHeight(pivot);
+        return pivot;
+    }
+
+    /**
+     * @brief Link nodes lo..hi (in key order) into a balanced subtree
+     * Recursion depth is log2(n), not n.
+     * @return Index of the subtree root
+     */
+    int32_t linkRange(int32_t lo, int32_t hi)
+    {
+        if (lo > hi) return kNull;
+        int32_t mid = lo + (hi - lo) / 2;
+        m_nodes[mid].left = linkRange(lo, mid - 1);
+        m_nodes[mid].right = linkRange(mid + 1, hi);
+        updateHeight(mid);
+        return mid;
+    }
+
+    /**
+     * @brief Restore the AVL invariant at one node
+     * @return Index of the new subtree root
+     */
+    int32_t rebalance(int32_t node)
+    {
+        updateHeight(node);
+        int balance = balanceOf(node);
+        if (balance > 1) {
+            if (balanceOf(m_nodes[node].left) < 0) {
+                m_nodes[node].left = rotateLeft(m_nodes[node].left);
+            }
+            return rotateRight(node);
+        }
+        if (balance < -1) {
+            if (balanceOf(m_nodes[node].right) > 0) {
+                m_nodes[node].right = rotateRight(m_nodes[node].right);
+            }
+            return rotateLeft(node);
+        }
+        return node;
+    }
+};
+
+#endif // BALANCEDBST_H
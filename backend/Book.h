@@ -4,6 +4,8 @@
 #include <QString>
 #include <QStringList>
 #include <QJsonObject>
+#include <cmath>
+#include <limits>
 
 /**
  * @brief Class representing a book in the digital library
@@ -81,6 +83,33 @@ class Book
      */
     bool hasGenre(const QString& genre) const;
 
+    /**
+     * @brief Normalized genre used as index key (trimmed, lowercased)
+     * Every genre index and genre lookup goes through this, so " Fiksi "
+     * and "fiksi" are the same genre.
+     * @param genre Genre as entered
+     * @return Key for genre indexes
+     */
+    static QString genreKey(const QString& genre) { return genre.trimmed().toLower(); }
+
+    static constexpr double kRatingScale = 100.0;  ///< ratingKey() units per rating point (two decimals)
+
+    /**
+     * @brief Fixed-point rating key (4.75 -> 475)
+     * Every rating index, sort key and rating aggregate goes through this,
+     * so they all round the same way. Values outside the qint32 range are
+     * clamped, so open bounds can be passed as-is.
+     * @param rating Rating as stored
+     * @return Rating in 1/kRatingScale units
+     */
+    static qint32 ratingKey(double rating)
+    {
+        double scaled = std::round(rating * kRatingScale);
+        if (scaled <= static_cast<double>(std::numeric_limits<qint32>::min())) return std::numeric_limits<qint32>::min();
+        if (scaled >= static_cast<double>(std::numeric_limits<qint32>::max())) return std::numeric_limits<qint32>::max();
+        return static_cast<qint32>(scaled);
+    }
+
     /**
      * @brief Get a formatted string representation of the book
      * @return QString formatted book information
@@ -126,7 +155,12 @@ inline Book::Book(int id, const QString& judul, const QString& penulis,
 
 inline bool Book::hasGenre(const QString& genre) const
 {
-    return m_genre.contains(genre, Qt::CaseInsensitive);
+    // Same normalization as the genre indexes (see genreKey)
+    const QString key = genreKey(genre);
+    for (const QString& g : m_genre) {
+        if (genreKey(g) == key) return true;
+    }
+    return false;
 }
 
 inline QString Book::toString() const
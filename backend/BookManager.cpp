@@ -4,14 +4,43 @@
 #include <QJsonObject>
 #include <QDebug>
 #include <QDateTime>
+#include <QSet>
 #include <algorithm>
 #include <set>
+#include <thread>
+#include <limits>
+#include <iterator>
 
 BookManager::BookManager()
-    : m_bstRoot(nullptr)
+    : m_version(1)
+    , m_readViewVersion(0)
+    , m_sortWorkers(0)
+    , m_parallelSortThreshold(kDefaultParallelSortThreshold)
+    , m_stats(kDefaultStatsMode)
 {
 }
 
+BookManager::BookManager(const BookManager& other, CatalogOnly)
+    : m_books(other.m_books)
+    , m_idIndex(other.m_idIndex)
+    , m_version(other.m_version)
+    , m_readViewVersion(0)
+    , m_sortWorkers(other.m_sortWorkers)
+    , m_parallelSortThreshold(other.m_parallelSortThreshold)
+    , m_titleTrigrams(other.m_titleTrigrams)
+    , m_authorTrigrams(other.m_authorTrigrams)
+    , m_titleTrie(other.m_titleTrie)
+    , m_authorTrie(other.m_authorTrie)
+    , m_genreIndex(other.m_genreIndex)
+    , m_yearIndex(other.m_yearIndex)
+    , m_ratingIndex(other.m_ratingIndex)
+    , m_stats(other.m_stats)
+    , m_store(other.m_store)
+{
+    std::copy(std::begin(other.m_secondaryIndexes), std::end(other.m_secondaryIndexes),
+              std::begin(m_secondaryIndexes));
+}
+
 bool BookManager::loadFromJson(const QString& filePath)
 {
     QFile file(filePath);
@@ -39,6 +68,8 @@ bool BookManager::loadFromJson(const QString& filePath)
             m_books.push_back(book);
         }
     }
+    rebuildIndexes();
+    markChanged();
 
     qDebug() << "Loaded" << m_books.size() << "books from" << filePath;
     return true;
@@ -71,44 +102,79 @@ bool BookManager::saveToJson(const QString& filePath)
 
 Book* BookManager::getBookById(int id)
 {
-    for (Book& book : m_books) {
-        if (book.getId() == id) {
-            return &book;
-        }
+    // O(1) lookup through the ID hash index instead of a linear scan
+    uint32_t slot = m_idIndex.find(id);
+    return slot != IdHashIndex::kNotFound ? &m_books[slot] : nullptr;
+}
+
+void BookManager::setBooks(const std::vector<Book>& books)
+{
+    m_books = books;
+    rebuildIndexes();
+    markChanged();
+}
+
+BookManager::Snapshot BookManager::getSnapshot() const
+{
+    // Aliasing pointer: keeps the whole view alive, points at its books
+    ReadView view = getReadView();
+    return Snapshot(view, &view->m_books);
+}
+
+BookManager::ReadView BookManager::getReadView() const
+{
+    // One copy per version; every reader of the same version shares it
+    if (!m_readView || m_readViewVersion != m_version) {
+        m_readView = ReadView(new BookManager(*this, CatalogOnly{}));
+        m_readViewVersion = m_version;
     }
-    return nullptr;
+    return m_readView;
 }
 
 void BookManager::addBook(const Book& book)
 {
     m_books.push_back(book);
+    m_idIndex.set(book.getId(), static_cast<uint32_t>(m_books.size() - 1));
+    m_store.push_back(book);
+    indexBook(book);
+    markChanged();
 }
 
 bool BookManager::removeBook(int id)
 {
     // Find the book to save it to undo stack before removing
-    Book* bookToDelete = getBookById(id);
-    if (bookToDelete) {
-        // Push to undo stack (LIFO - Last In First Out)
-        m_deletedBooks.push(*bookToDelete);
-        qDebug() << "Added to undo stack:" << bookToDelete->getJudul();
+    uint32_t slot = m_idIndex.find(id);
+    if (slot == IdHashIndex::kNotFound) {
+        return false;
     }
     
-    auto it = std::remove_if(m_books.begin(), m_books.end(),
-                             [id](const Book& book) { return book.getId() == id; });
-    
-    if (it != m_books.end()) {
-        m_books.erase(it, m_books.end());
-        return true;
+    // Push to undo stack (LIFO - Last In First Out)
+    const Book& bookToDelete = m_books[slot];
+    m_deletedBooks.push(bookToDelete);
+    qDebug() << "Added to undo stack:" << bookToDelete.getJudul();
+    unindexBook(bookToDelete);
+    
+    // Erase keeps the current (sorted) order; only books after the gap change slot
+    m_books.erase(m_books.begin() + slot);
+    m_store.erase(slot);
+    m_idIndex.erase(id);
+    for (size_t i = slot; i < m_books.size(); i++) {
+        m_idIndex.set(m_books[i].getId(), static_cast<uint32_t>(i));
     }
-    return false;
+    markChanged();
+    return true;
 }
 
 bool BookManager::updateBook(const Book& book)
 {
-    Book* existingBook = getBookById(book.getId());
-    if (existingBook) {
+    uint32_t slot = m_idIndex.find(book.getId());
+    if (slot != IdHashIndex::kNotFound) {
+        Book* existingBook = &m_books[slot];
+        unindexBook(*existingBook);
         *existingBook = book;
+        m_store.set(slot, book);
+        indexBook(book);
+        markChanged();
         return true;
     }
     return false;
@@ -118,113 +184,599 @@ bool BookManager::updateBook(const Book& book)
 // SORTING ALGORITHMS - QuickSort
 // ============================================================================
 
+namespace
+{
+    /// Case-folded text plus book ID, computed once per book for title/author sorts
+    using FoldedKey = std::pair<QString, int>;
+
+    FoldedKey foldedTitleKey(const Book& book) { return FoldedKey(book.getJudul().toLower(), book.getId()); }
+    FoldedKey foldedAuthorKey(const Book& book) { return FoldedKey(book.getPenulis().toLower(), book.getId()); }
+
+    bool foldedAscending(const FoldedKey& a, const FoldedKey& b)
+    {
+        int cmp = QString::compare(a.first, b.first);
+        return cmp != 0 ? cmp < 0 : a.second < b.second;
+    }
+
+    bool foldedDescending(const FoldedKey& a, const FoldedKey& b)
+    {
+        int cmp = QString::compare(a.first, b.first);
+        return cmp != 0 ? cmp > 0 : a.second > b.second;
+    }
+
+    /**
+     * Three-way compare of text.toLower() with an already folded key, one
+     * UTF-16 unit at a time and without allocating. Matches the order of the
+     * folded title/author sorts (except for the few characters whose
+     * lowercase form is longer than one unit).
+     */
+    int compareFoldedText(const QString& text, const QString& foldedKey)
+    {
+        int n = std::min<int>(text.size(), foldedKey.size());
+        for (int i = 0; i < n; i++) {
+            ushort a = text.at(i).toLower().unicode();
+            ushort b = foldedKey.at(i).unicode();
+            if (a != b) return a < b ? -1 : 1;
+        }
+        return text.size() < foldedKey.size() ? -1 : (text.size() > foldedKey.size() ? 1 : 0);
+    }
+
+    /**
+     * Pack an integer field and the book ID into one 64-bit key. Sorting the
+     * packed keys ascending orders by field first and by ID on ties; for a
+     * descending sort the whole key is inverted, giving the exact reverse of
+     * the ascending order (same as walking a secondary index backwards).
+     */
+    quint64 packFieldKey(qint32 field, int id, bool ascending)
+    {
+        quint32 primary = Sorting::toOrderedUnsigned(field);
+        quint32 secondary = Sorting::toOrderedUnsigned(static_cast<qint32>(id));
+        quint64 key = (static_cast<quint64>(primary) << 32) | secondary;
+        return ascending ? key : ~key;
+    }
+
+    /// Ratings are sorted as fixed-point integers with two decimals (4.75 -> 475)
+    qint32 fixedRating(const Book& book)
+    {
+        return Book::ratingKey(book.getRating());
+    }
+
+    /// Secondary index entry using the same keys as the sorts above
+    SecondaryIndex::Entry indexEntry(BookManager::SortField field, const Book& book)
+    {
+        switch (field) {
+            case BookManager::SortField::Title:  return SecondaryIndex::Entry(book.getJudul().toLower(), 0, book.getId());
+            case BookManager::SortField::Author: return SecondaryIndex::Entry(book.getPenulis().toLower(), 0, book.getId());
+            case BookManager::SortField::Year:   return SecondaryIndex::Entry(QString(), book.getTahun(), book.getId());
+            case BookManager::SortField::Rating: return SecondaryIndex::Entry(QString(), fixedRating(book), book.getId());
+        }
+        return SecondaryIndex::Entry(QString(), 0, book.getId());
+    }
+}
+
+template<typename T, typename Compare>
+void BookManager::sortItems(std::vector<T>& items, Compare compare) const
+{
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    int workers = m_sortWorkers > 0 ? m_sortWorkers : static_cast<int>(hardwareThreads);
+
+    if (workers > 1 && items.size() >= m_parallelSortThreshold) {
+        // Parallel stable MergeSort for large catalogs
+        Sorting::parallelMergeSort(items, compare, workers);
+    } else {
+        Sorting::quickSort(items, compare);
+    }
+}
+
+template<typename KeyFn, typename KeyCompare>
+void BookManager::sortBooksByKey(KeyFn getKey, KeyCompare compareKeys)
+{
+    // Decorate: one key per book (O(n) allocations instead of O(n log n))
+    auto keys = Sorting::decorate(m_books, getKey);
+
+    // Sort the compact keys, then move every Book once into its final slot
+    sortItems(keys, Sorting::keyedCompare(compareKeys));
+    applySortedKeys(keys);
+}
+
+template<typename K>
+void BookManager::applySortedKeys(const std::vector<Sorting::KeyedIndex<K>>& keys)
+{
+    // Books and columns follow the same permutation; no string is touched again
+    Sorting::undecorate(m_books, keys);
+    m_store.permute(keys);
+    rebuildIdIndex();
+}
+
+template<typename KeyFn, typename KeyCompare>
+void BookManager::sortIndicesByKey(const std::vector<Book>& books, std::vector<uint32_t>& indices,
+                                   KeyFn getKey, KeyCompare compareKeys) const
+{
+    if (indices.size() < 2) return;
+
+    auto keys = Sorting::decorateIndices(books, indices, getKey);
+    sortItems(keys, Sorting::keyedCompare(compareKeys));
+    for (size_t i = 0; i < keys.size(); i++) {
+        indices[i] = keys[i].index;
+    }
+}
+
 void BookManager::quickSortByTitle(bool ascending)
 {
     if (m_books.empty()) return;
 
-    auto compare = ascending
-        ? [](const Book& a, const Book& b) { 
-            return a.getJudul().toLower() < b.getJudul().toLower(); 
-          }
-        : [](const Book& a, const Book& b) { 
-            return a.getJudul().toLower() > b.getJudul().toLower(); 
-          };
-
-    Sorting::quickSort(m_books, compare);
+    // Lowercased titles are computed once per book, not twice per comparison
+    sortBooksByKey(foldedTitleKey, ascending ? foldedAscending : foldedDescending);
 }
 
 void BookManager::quickSortByYear(bool ascending)
 {
     if (m_books.empty()) return;
 
-    auto compare = ascending
-        ? [](const Book& a, const Book& b) { return a.getTahun() < b.getTahun(); }
-        : [](const Book& a, const Book& b) { return a.getTahun() > b.getTahun(); };
-
-    Sorting::quickSort(m_books, compare);
+    // Years span a tiny range: linear-time counting/radix sort on a packed key
+    auto keys = Sorting::decorate(m_books, [ascending](const Book& b) {
+        return packFieldKey(b.getTahun(), b.getId(), ascending);
+    });
+    Sorting::radixSort(keys, Sorting::SortOrder::Ascending);
+    applySortedKeys(keys);
 }
 
 void BookManager::quickSortByRating(bool ascending)
 {
     if (m_books.empty()) return;
 
-    auto compare = ascending
-        ? [](const Book& a, const Book& b) { return a.getRating() < b.getRating(); }
-        : [](const Book& a, const Book& b) { return a.getRating() > b.getRating(); };
-
-    Sorting::quickSort(m_books, compare);
+    // Ratings become fixed-point integers so they can take the radix path too
+    auto keys = Sorting::decorate(m_books, [ascending](const Book& b) {
+        return packFieldKey(fixedRating(b), b.getId(), ascending);
+    });
+    Sorting::radixSort(keys, Sorting::SortOrder::Ascending);
+    applySortedKeys(keys);
 }
 
 void BookManager::quickSortByAuthor(bool ascending)
 {
     if (m_books.empty()) return;
 
-    auto compare = ascending
-        ? [](const Book& a, const Book& b) { 
-            return a.getPenulis().toLower() < b.getPenulis().toLower(); 
-          }
-        : [](const Book& a, const Book& b) { 
-            return a.getPenulis().toLower() > b.getPenulis().toLower(); 
-          };
+    sortBooksByKey(foldedAuthorKey, ascending ? foldedAscending : foldedDescending);
+}
 
-    Sorting::quickSort(m_books, compare);
+void BookManager::sortIndices(const std::vector<Book>& books, std::vector<uint32_t>& indices,
+                              SortField field, bool ascending) const
+{
+    switch (field) {
+        case SortField::Title:
+            sortIndicesByKey(books, indices, foldedTitleKey, ascending ? foldedAscending : foldedDescending);
+            break;
+        case SortField::Author:
+            sortIndicesByKey(books, indices, foldedAuthorKey, ascending ? foldedAscending : foldedDescending);
+            break;
+        case SortField::Year:
+        case SortField::Rating: {
+            auto keys = Sorting::decorateIndices(books, indices, [field, ascending](const Book& b) {
+                qint32 value = field == SortField::Year ? b.getTahun() : fixedRating(b);
+                return packFieldKey(value, b.getId(), ascending);
+            });
+            Sorting::radixSort(keys);
+            for (size_t i = 0; i < keys.size(); i++) {
+                indices[i] = keys[i].index;
+            }
+            break;
+        }
+    }
+}
+
+void BookManager::topKIndices(const std::vector<Book>& books, std::vector<uint32_t>& indices, size_t k,
+                              SortField field, bool ascending) const
+{
+    if (indices.size() <= k) {
+        sortIndices(books, indices, field, ascending);
+        return;
+    }
+
+    // Same keys as sortIndices(), so the k survivors come out in the same order
+    auto keepFirst = [&indices, k](auto& keys, auto compare) {
+        Sorting::topK(keys, k, compare);
+        indices.resize(keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            indices[i] = keys[i].index;
+        }
+    };
+    switch (field) {
+        case SortField::Title:
+        case SortField::Author: {
+            auto keys = Sorting::decorateIndices(books, indices, field == SortField::Title ? foldedTitleKey : foldedAuthorKey);
+            keepFirst(keys, Sorting::keyedCompare(ascending ? foldedAscending : foldedDescending));
+            break;
+        }
+        case SortField::Year:
+        case SortField::Rating: {
+            auto keys = Sorting::decorateIndices(books, indices, [field, ascending](const Book& b) {
+                qint32 value = field == SortField::Year ? b.getTahun() : fixedRating(b);
+                return packFieldKey(value, b.getId(), ascending);
+            });
+            keepFirst(keys, Sorting::keyedCompare(std::less<quint64>()));
+            break;
+        }
+    }
+}
+
+std::vector<uint32_t> BookManager::getSortedIndices(SortField field, bool ascending) const
+{
+    std::vector<uint32_t> indices(m_books.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        indices[i] = static_cast<uint32_t>(i);
+    }
+    sortIndices(m_books, indices, field, ascending);
+    return indices;
+}
+
+// ============================================================================
+// SECONDARY INDEXES - Sorted views maintained on every change
+// ============================================================================
+
+void BookManager::indexBook(const Book& book)
+{
+    for (int f = 0; f < kSortFieldCount; f++) {
+        m_secondaryIndexes[f].insert(indexEntry(static_cast<SortField>(f), book));
+    }
+    m_titleTrigrams.insert(book.getId(), book.getJudul());
+    m_authorTrigrams.insert(book.getId(), book.getPenulis());
+    m_titleTrie.insert(book.getJudul(), book.getId(), fixedRating(book));
+    m_authorTrie.insert(book.getPenulis(), book.getId(), fixedRating(book));
+    for (const QString& genre : book.getGenre()) {
+        m_genreIndex[Book::genreKey(genre)].add(static_cast<uint32_t>(book.getId()));
+    }
+    m_yearIndex.insert(book.getTahun(), book.getId());
+    m_ratingIndex.insert(fixedRating(book), book.getId());
+    m_stats.add(book);
+}
+
+void BookManager::unindexBook(const Book& book)
+{
+    for (int f = 0; f < kSortFieldCount; f++) {
+        m_secondaryIndexes[f].erase(indexEntry(static_cast<SortField>(f), book));
+    }
+    m_titleTrigrams.erase(book.getId());
+    m_authorTrigrams.erase(book.getId());
+    m_titleTrie.erase(book.getJudul(), book.getId());
+    m_authorTrie.erase(book.getPenulis(), book.getId());
+    for (const QString& genre : book.getGenre()) {
+        auto it = m_genreIndex.find(Book::genreKey(genre));
+        if (it == m_genreIndex.end()) continue;
+        it.value().remove(static_cast<uint32_t>(book.getId()));
+        if (it.value().empty()) m_genreIndex.erase(it);
+    }
+    m_yearIndex.erase(book.getTahun(), book.getId());
+    m_ratingIndex.erase(fixedRating(book), book.getId());
+    m_stats.remove(book);
+}
+
+void BookManager::rebuildIdIndex()
+{
+    m_idIndex.clear();
+    m_idIndex.reserve(m_books.size());
+    for (size_t i = 0; i < m_books.size(); i++) {
+        // Keep the first book with a given ID, like the old linear scan did
+        if (m_idIndex.find(m_books[i].getId()) == IdHashIndex::kNotFound) {
+            m_idIndex.set(m_books[i].getId(), static_cast<uint32_t>(i));
+        }
+    }
+}
+
+void BookManager::rebuildIndexes()
+{
+    rebuildIdIndex();
+    m_store.assign(m_books);
+    for (int f = 0; f < kSortFieldCount; f++) {
+        std::vector<SecondaryIndex::Entry> entries;
+        entries.reserve(m_books.size());
+        for (const Book& book : m_books) {
+            entries.push_back(indexEntry(static_cast<SortField>(f), book));
+        }
+        m_secondaryIndexes[f].assign(std::move(entries));
+    }
+
+    std::vector<std::pair<int, QString>> titles, authors;
+    titles.reserve(m_books.size());
+    authors.reserve(m_books.size());
+    for (const Book& book : m_books) {
+        titles.emplace_back(book.getId(), book.getJudul());
+        authors.emplace_back(book.getId(), book.getPenulis());
+    }
+    m_titleTrigrams.assign(titles);
+    m_authorTrigrams.assign(authors);
+
+    m_titleTrie.clear();
+    m_authorTrie.clear();
+    m_genreIndex.clear();
+    for (const Book& book : m_books) {
+        m_titleTrie.insert(book.getJudul(), book.getId(), fixedRating(book));
+        m_authorTrie.insert(book.getPenulis(), book.getId(), fixedRating(book));
+        for (const QString& genre : book.getGenre()) {
+            m_genreIndex[Book::genreKey(genre)].add(static_cast<uint32_t>(book.getId()));
+        }
+    }
+
+    // The range indexes only need ID, year and rating: read them from the columns
+    const std::vector<qint32>& ids = m_store.ids();
+    const std::vector<qint32>& yearColumn = m_store.years();
+    const std::vector<qint32>& ratingColumn = m_store.ratings();
+    std::vector<RangeIndex::Entry> years, ratings;
+    years.reserve(ids.size());
+    ratings.reserve(ids.size());
+    for (size_t slot = 0; slot < ids.size(); slot++) {
+        years.push_back(RangeIndex::Entry{yearColumn[slot], ids[slot]});
+        ratings.push_back(RangeIndex::Entry{ratingColumn[slot], ids[slot]});
+    }
+    m_yearIndex.assign(std::move(years));
+    m_ratingIndex.assign(std::move(ratings));
+
+    rebuildStats();
+}
+
+void BookManager::rebuildStats()
+{
+    m_stats.clear();
+    for (const Book& book : m_books) m_stats.add(book);
+}
+
+void BookManager::setStatsMode(CatalogStats::Mode mode)
+{
+    if (mode == m_stats.mode()) return;
+    m_stats.setMode(mode);
+    rebuildStats();
+    markChanged();
+}
+
+void BookManager::clear()
+{
+    m_books.clear();
+    m_idIndex.clear();
+    m_store.clear();
+    for (SecondaryIndex& index : m_secondaryIndexes) {
+        index.clear();
+    }
+    m_titleTrigrams.clear();
+    m_authorTrigrams.clear();
+    m_titleTrie.clear();
+    m_authorTrie.clear();
+    m_genreIndex.clear();
+    m_yearIndex.clear();
+    m_ratingIndex.clear();
+    m_stats.clear();
+    markChanged();
 }
 
 // ============================================================================
 // SEARCHING ALGORITHMS
 // ============================================================================
 
+std::vector<int> BookManager::findIdsContaining(const QString& fragment, bool includeAuthor) const
+{
+    std::vector<int> ids = m_titleTrigrams.findContaining(fragment);
+    if (!includeAuthor) return ids;
+
+    // Merge the two ascending ID lists (a book can match on both)
+    std::vector<int> byAuthor = m_authorTrigrams.findContaining(fragment);
+    std::vector<int> merged;
+    merged.reserve(ids.size() + byAuthor.size());
+    std::set_union(ids.begin(), ids.end(), byAuthor.begin(), byAuthor.end(), std::back_inserter(merged));
+    return merged;
+}
+
+std::vector<int> BookManager::refineIdsContaining(const std::vector<int>& candidates, const QString& fragment,
+                                                  bool includeAuthor) const
+{
+    QString needle = fragment.toLower();
+    std::vector<int> ids;
+    for (int id : candidates) {
+        if (matchesText(id, needle, includeAuthor)) ids.push_back(id);
+    }
+    return ids;
+}
+
+bool BookManager::matchesText(int id, const QString& foldedFragment, bool includeAuthor) const
+{
+    const QString* title = m_titleTrigrams.textOf(id);
+    if (title && TextScan::contains(*title, foldedFragment)) return true;
+    if (!includeAuthor) return false;
+    const QString* author = m_authorTrigrams.textOf(id);
+    return author && TextScan::contains(*author, foldedFragment);
+}
+
+size_t BookManager::estimateIdsContaining(const QString& fragment, bool includeAuthor) const
+{
+    size_t estimate = m_titleTrigrams.estimateContaining(fragment);
+    if (includeAuthor) estimate += m_authorTrigrams.estimateContaining(fragment);
+    return std::min(estimate, m_books.size());
+}
+
+const Book* BookManager::findByTitle(const QString& title) const
+{
+    SecondaryIndex::Entry probe(title.toLower(), 0, std::numeric_limits<int>::min());
+    const SecondaryIndex& byTitle = getSecondaryIndex(SortField::Title);
+    auto it = byTitle.lowerBound(probe);
+    if (it == byTitle.end() || it->text != probe.text) return nullptr;
+
+    uint32_t slot = m_idIndex.find(it->id);
+    return slot != IdHashIndex::kNotFound ? &m_books[slot] : nullptr;
+}
+
+QStringList BookManager::completePrefix(const QString& prefix, int limit) const
+{
+    QStringList suggestions;
+    if (limit <= 0) return suggestions;
+
+    std::vector<PrefixTrie::Completion> titles = m_titleTrie.complete(prefix, limit);
+    std::vector<PrefixTrie::Completion> authors = m_authorTrie.complete(prefix, limit);
+
+    // Merge both ranked lists by score; a title equal to an author is listed once
+    QSet<QString> seen;
+    size_t t = 0, a = 0;
+    while (suggestions.size() < limit && (t < titles.size() || a < authors.size())) {
+        bool takeTitle = a == authors.size() || (t < titles.size() && titles[t].score >= authors[a].score);
+        const PrefixTrie::Completion& pick = takeTitle ? titles[t++] : authors[a++];
+
+        uint32_t slot = m_idIndex.find(pick.id);
+        if (slot == IdHashIndex::kNotFound) continue;
+        const Book& book = m_books[slot];
+        QString text = takeTitle ? book.getJudul() : book.getPenulis();
+        QString folded = text.toLower();
+        if (seen.contains(folded)) continue;
+        seen.insert(folded);
+        suggestions.append(text);
+    }
+    return suggestions;
+}
+
+std::vector<Book> BookManager::fuzzySearchByTitle(const QString& title, int maxDistance, size_t limit) const
+{
+    std::vector<std::pair<int, int>> matches = m_titleTrigrams.findSimilar(title, std::max(0, maxDistance));
+
+    // Rank: closest first, then best rated, then lowest ID
+    struct Ranked {
+        int distance;
+        qint32 rating;
+        int id;
+        uint32_t slot;
+    };
+    std::vector<Ranked> ranked;
+    ranked.reserve(matches.size());
+    for (const auto& match : matches) {
+        uint32_t slot = m_idIndex.find(match.first);
+        if (slot == IdHashIndex::kNotFound) continue;
+        ranked.push_back(Ranked{match.second, fixedRating(m_books[slot]), match.first, slot});
+    }
+    Sorting::quickSort(ranked, [](const Ranked& a, const Ranked& b) {
+        if (a.distance != b.distance) return a.distance < b.distance;
+        if (a.rating != b.rating) return a.rating > b.rating;
+        return a.id < b.id;
+    });
+
+    if (limit > 0 && ranked.size() > limit) ranked.resize(limit);
+    std::vector<Book> results;
+    results.reserve(ranked.size());
+    for (const Ranked& r : ranked) {
+        results.push_back(m_books[r.slot]);
+    }
+    return results;
+}
+
 Book* BookManager::binarySearchByTitle(const QString& title)
 {
     if (m_books.empty()) return nullptr;
 
-    // Use Searching::binarySearchByKey from library
+    // Use Searching::binarySearchBy from library: each probe compares the
+    // title with the folded key in place instead of building a lowered copy
     QString searchKey = title.toLower();
-    std::function<QString(const Book&)> getKey = [](const Book& book) -> QString { 
-        return book.getJudul().toLower(); 
-    };
-    
-    int index = Searching::binarySearchByKey(m_books, searchKey, getKey);
+    int index = Searching::binarySearchBy(m_books, searchKey, [](const Book& book, const QString& key) {
+        return compareFoldedText(book.getJudul(), key);
+    });
 
     return (index != -1) ? &m_books[index] : nullptr;
 }
 
 std::vector<Book> BookManager::searchByGenre(const QString& genre) const
 {
-    std::vector<Book> result;
-    for (const Book& book : m_books) {
-        if (book.hasGenre(genre)) {
-            result.push_back(book);
+    const RoaringBitmap* ids = getGenreBitmap(genre);
+    return ids ? booksInBitmap(*ids) : std::vector<Book>();
+}
+
+std::vector<Book> BookManager::searchByGenres(const QStringList& genres, bool matchAll) const
+{
+    return booksInBitmap(getGenresBitmap(genres, matchAll));
+}
+
+const RoaringBitmap* BookManager::getGenreBitmap(const QString& genre) const
+{
+    auto it = m_genreIndex.constFind(Book::genreKey(genre));
+    return it != m_genreIndex.constEnd() ? &it.value() : nullptr;
+}
+
+RoaringBitmap BookManager::getGenresBitmap(const QStringList& genres, bool matchAll) const
+{
+    RoaringBitmap result;
+    bool first = true;
+    for (const QString& genre : genres) {
+        const RoaringBitmap* ids = getGenreBitmap(genre);
+        if (!ids) {
+            if (matchAll) return RoaringBitmap();  // No book has this genre, so none has all
+            continue;
         }
+        if (first) {
+            result = *ids;
+            first = false;
+        } else {
+            result = matchAll ? RoaringBitmap::intersect(result, *ids) : RoaringBitmap::unite(result, *ids);
+        }
+        if (matchAll && result.empty()) break;
     }
     return result;
 }
 
-std::vector<Book> BookManager::searchByAuthor(const QString& author) const
+size_t BookManager::countByGenre(const QString& genre) const
 {
-    std::vector<Book> result;
-    QString authorLower = author.toLower();
-    
-    for (const Book& book : m_books) {
-        if (book.getPenulis().toLower().contains(authorLower)) {
-            result.push_back(book);
-        }
+    const RoaringBitmap* ids = getGenreBitmap(genre);
+    return ids ? ids->cardinality() : 0;
+}
+
+std::vector<Book> BookManager::booksInBitmap(const RoaringBitmap& ids) const
+{
+    std::vector<uint32_t> slots;
+    slots.reserve(ids.cardinality());
+    ids.forEach([&](uint32_t id) {
+        uint32_t slot = m_idIndex.find(static_cast<int>(id));
+        if (slot != IdHashIndex::kNotFound) slots.push_back(slot);
+    });
+    return booksAtSlots(slots);
+}
+
+std::vector<Book> BookManager::booksInRange(const RangeIndex::View& range) const
+{
+    std::vector<uint32_t> slots;
+    slots.reserve(range.size());
+    for (const RangeIndex::Entry& entry : range) {
+        uint32_t slot = m_idIndex.find(entry.id);
+        if (slot != IdHashIndex::kNotFound) slots.push_back(slot);
     }
-    return result;
+    return booksAtSlots(slots);
 }
 
-std::vector<Book> BookManager::searchByYearRange(int minYear, int maxYear) const
+std::vector<Book> BookManager::booksAtSlots(std::vector<uint32_t>& slots) const
 {
+    // Sorting the slots keeps the collection's current order
+    Sorting::quickSort(slots);
+
     std::vector<Book> result;
-    for (const Book& book : m_books) {
-        int year = book.getTahun();
-        if (year >= minYear && year <= maxYear) {
-            result.push_back(book);
-        }
+    result.reserve(slots.size());
+    for (uint32_t slot : slots) {
+        result.push_back(m_books[slot]);
     }
     return result;
 }
 
+std::vector<Book> BookManager::searchByAuthor(const QString& author) const
+{
+    // Author trigram index (vectorized scan of the packed authors for 1-2 characters)
+    // instead of toLower().contains() on every book
+    std::vector<uint32_t> slots;
+    for (int id : m_authorTrigrams.findContaining(author)) {
+        uint32_t slot = m_idIndex.find(id);
+        if (slot != IdHashIndex::kNotFound) slots.push_back(slot);
+    }
+    return booksAtSlots(slots);
+}
+
+std::vector<Book> BookManager::searchByYearRange(int minYear, int maxYear) const
+{
+    return booksInRange(yearRange(minYear, maxYear));
+}
+
+std::vector<Book> BookManager::searchByRatingRange(double minRating, double maxRating) const
+{
+    return booksInRange(ratingRange(minRating, maxRating));
+}
+
 std::vector<QString> BookManager::getAllGenres() const
 {
     std::set<QString> genreSet;
@@ -256,6 +808,10 @@ bool BookManager::undoDelete()
     
     // Add book back to collection
     m_books.push_back(restoredBook);
+    m_idIndex.set(restoredBook.getId(), static_cast<uint32_t>(m_books.size() - 1));
+    m_store.push_back(restoredBook);
+    indexBook(restoredBook);
+    markChanged();
     
     qDebug() << "Restored book:" << restoredBook.getJudul();
     return true;
@@ -315,51 +871,53 @@ std::vector<BookManager::BorrowRequest> BookManager::getAllBorrowRequests() cons
 // PRIORITY QUEUE - Popular Books by Rating Implementation
 // ============================================================================
 
-std::vector<Book> BookManager::getTopRatedBooks(int topN)
+std::vector<Book> BookManager::getTopRatedBooks(int topN) const
 {
-    if (m_books.empty()) {
-        return std::vector<Book>();
-    }
-    
-    // Create max heap (priority queue) based on rating
-    auto compareRating = [](const Book& a, const Book& b) {
-        return a.getRating() < b.getRating(); // Max heap
-    };
-    
-    std::priority_queue<Book, std::vector<Book>, decltype(compareRating)> maxHeap(compareRating);
-    
-    // Add all books to priority queue
-    for (const Book& book : m_books) {
-        maxHeap.push(book);
-    }
-    
-    // Extract top N books
-    std::vector<Book> topBooks;
-    for (int i = 0; i < topN && !maxHeap.empty(); i++) {
-        topBooks.push_back(maxHeap.top());
-        maxHeap.pop();
-    }
+    if (topN <= 0) return std::vector<Book>();
+    return booksByRatingDesc(std::numeric_limits<qint32>::min(), 0, static_cast<size_t>(topN));
+}
     
-    return topBooks;
+std::vector<Book> BookManager::getPopularBooks(double minRating) const
+{
+    return booksByRatingDesc(ratingKey(minRating), 0, 0);
 }
 
-std::vector<Book> BookManager::getPopularBooks(double minRating)
+std::vector<Book> BookManager::getPopularBooks(double minRating, size_t offset, size_t limit) const
 {
-    std::vector<Book> popularBooks;
-    
-    for (const Book& book : m_books) {
-        if (book.getRating() >= minRating) {
-            popularBooks.push_back(book);
+    return booksByRatingDesc(ratingKey(minRating), offset, limit);
+}
+
+std::vector<Book> BookManager::booksByRatingDesc(qint32 minKey, size_t offset, size_t limit) const
+{
+    std::vector<Book> result;
+    size_t available = m_ratingIndex.countAtLeast(minKey);
+    if (offset >= available) return result;
+    size_t wanted = available - offset;
+    if (limit > 0) wanted = std::min(wanted, limit);
+    result.reserve(wanted);
+    
+    // Best-first order is rating groups from the top down, each group walked
+    // forward so ties come out by ascending ID. Locate the group holding the
+    // offset-th book by rank: select the entry offset places from the top,
+    // then step into its group by the number of books above the group.
+    const size_t total = m_ratingIndex.size();
+    qint32 key = m_ratingIndex.select(total - 1 - offset).key;
+    auto groupBegin = m_ratingIndex.lowerBound(key);
+    auto groupEnd = m_ratingIndex.upperBound(key);
+    auto it = groupBegin + static_cast<std::ptrdiff_t>(offset - static_cast<size_t>(m_ratingIndex.end() - groupEnd));
+    
+    while (result.size() < wanted) {
+        for (; it != groupEnd && result.size() < wanted; ++it) {
+            uint32_t slot = m_idIndex.find(it->id);
+            if (slot != IdHashIndex::kNotFound) result.push_back(m_books[slot]);
         }
+        if (groupBegin == m_ratingIndex.begin()) break;
+        groupEnd = groupBegin;
+        groupBegin = m_ratingIndex.lowerBound(std::prev(groupEnd)->key);
+        it = groupBegin;
     }
     
-    // Sort by rating (descending)
-    std::sort(popularBooks.begin(), popularBooks.end(),
-              [](const Book& a, const Book& b) {
-                  return a.getRating() > b.getRating();
-              });
-    
-    return popularBooks;
+    return result;
 }
 
 // ============================================================================
@@ -368,106 +926,72 @@ std::vector<Book> BookManager::getPopularBooks(double minRating)
 
 void BookManager::buildBST()
 {
-    m_bstRoot = nullptr;
-    
-    for (const Book& book : m_books) {
-        m_bstRoot = insertBST(m_bstRoot, book);
-    }
-    
-    qDebug() << "Built BST with" << m_books.size() << "books";
-}
-
-std::shared_ptr<BookManager::BSTNode> BookManager::insertBST(std::shared_ptr<BSTNode> node, const Book& book)
-{
-    if (!node) {
-        return std::make_shared<BSTNode>(book);
-    }
-    
-    // Compare by title (case-insensitive)
-    QString currentTitle = node->book.getJudul().toLower();
-    QString newTitle = book.getJudul().toLower();
-    
-    if (newTitle < currentTitle) {
-        node->left = insertBST(node->left, book);
-    } else if (newTitle > currentTitle) {
-        node->right = insertBST(node->right, book);
+    const SecondaryIndex& byTitle = getSecondaryIndex(SortField::Title);
+    
+    if (byTitle.size() != m_books.size()) {
+        // Index does not cover every book (duplicate IDs): fall back to AVL inserts
+        m_bst.clear();
+        m_bst.reserve(m_books.size());
+        for (const Book& book : m_books) {
+            m_bst.insert(book.getJudul().toLower(), book);
+        }
+    } else {
+        // Bulk load in O(n): the title index already holds the lowercased titles in order.
+        // For duplicate titles keep the book that comes first in m_books, like inserting did.
+        std::vector<std::pair<const QString*, uint32_t>> unique;  // (title, slot in m_books)
+        unique.reserve(byTitle.size());
+        for (const SecondaryIndex::Entry& entry : byTitle) {
+            uint32_t slot = m_idIndex.find(entry.id);
+            if (!unique.empty() && *unique.back().first == entry.text) {
+                if (slot < unique.back().second) unique.back().second = slot;
+            } else {
+                unique.emplace_back(&entry.text, slot);
+            }
+        }
+        
+        m_bst.assignSorted(unique.size(),
+                           [&unique](size_t i) -> const QString& { return *unique[i].first; },
+                           [this, &unique](size_t i) -> const Book& { return m_books[unique[i].second]; });
     }
-    // If equal, don't insert duplicate
     
-    return node;
+    qDebug() << "Built BST with" << m_bst.size() << "books, height" << m_bst.height();
 }
 
 Book* BookManager::searchBST(const QString& title)
 {
-    return searchBSTHelper(m_bstRoot, title);
-}
-
-Book* BookManager::searchBSTHelper(std::shared_ptr<BSTNode> node, const QString& title)
-{
-    if (!node) {
-        return nullptr;
-    }
-    
-    QString currentTitle = node->book.getJudul().toLower();
-    QString searchTitle = title.toLower();
-    
-    if (searchTitle == currentTitle) {
-        return &(node->book);
-    } else if (searchTitle < currentTitle) {
-        return searchBSTHelper(node->left, title);
-    } else {
-        return searchBSTHelper(node->right, title);
-    }
+    return m_bst.find(title.toLower());
 }
 
 std::vector<Book> BookManager::searchBSTPartial(const QString& partialTitle)
 {
     std::vector<Book> results;
     
-    if (!m_bstRoot) {
+    if (m_bst.empty()) {
         qDebug() << "BST is empty, cannot perform partial search";
         return results;
     }
     
-    // Perform in-order traversal and collect matching books
-    searchBSTPartialHelper(m_bstRoot, partialTitle.toLower(), results);
-    
-    qDebug() << "BST Partial Search found" << results.size() << "books matching:" << partialTitle;
-    return results;
-}
-
-void BookManager::searchBSTPartialHelper(std::shared_ptr<BSTNode> node, const QString& partialTitle, std::vector<Book>& results)
-{
-    if (!node) {
-        return;
+    // Trigram index narrows to matching titles; keep the ones the BST holds
+    for (int id : m_titleTrigrams.findContaining(partialTitle)) {
+        const Book* node = m_bst.find(*m_titleTrigrams.textOf(id));
+        if (node && node->getId() == id) {
+            results.push_back(*node);
+        }
     }
     
-    // In-order traversal: left -> current -> right
-    searchBSTPartialHelper(node->left, partialTitle, results);
-    
-    // Check if current node's title contains the partial title (case-insensitive)
-    QString currentTitle = node->book.getJudul().toLower();
-    if (currentTitle.contains(partialTitle)) {
-        results.push_back(node->book);
-    }
+    // BST keys are unique lowercased titles, so this is the in-order sequence
+    Sorting::sortByKey(results, foldedTitleKey, foldedAscending);
     
-    searchBSTPartialHelper(node->right, partialTitle, results);
+    qDebug() << "BST Partial Search found" << results.size() << "books matching:" << partialTitle;
+    return results;
 }
 
 std::vector<Book> BookManager::getBSTInOrder()
 {
     std::vector<Book> result;
-    inOrderTraversal(m_bstRoot, result);
+    result.reserve(m_bst.size());
+    m_bst.inOrder([&result](const QString&, const Book& book) {
+        result.push_back(book);
+    });
     return result;
 }
-
-void BookManager::inOrderTraversal(std::shared_ptr<BSTNode> node, std::vector<Book>& result)
-{
-    if (!node) {
-        return;
-    }
-    
-    inOrderTraversal(node->left, result);
-    result.push_back(node->book);
-    inOrderTraversal(node->right, result);
-}
@@ -5,10 +5,20 @@
 #include "Graph.h"
 #include "Sorting.h"
 #include "Searching.h"
+#include "SecondaryIndex.h"
+#include "IdHashIndex.h"
+#include "BalancedBST.h"
+#include "TrigramIndex.h"
+#include "PrefixTrie.h"
+#include "RoaringBitmap.h"
+#include "RangeIndex.h"
+#include "CatalogStats.h"
+#include "BookStore.h"
 #include <vector>
 #include <stack>
 #include <queue>
 #include <QString>
+#include <QHash>
 #include <QJsonDocument>
 #include <functional>
 #include <memory>
@@ -46,23 +56,94 @@ class BookManager
 
     /**
      * @brief Get all books in the collection
-     * @return Vector of all books
+     * @return Vector of all books (a full copy - prefer books() or getSnapshot() for reading)
      */
     std::vector<Book> getAllBooks() const { return m_books; }
 
+    /**
+     * @brief Read-only view of the collection (no copy)
+     * Valid until the next change; use getSnapshot() to keep the data around.
+     * @return Const reference to the books
+     */
+    const std::vector<Book>& books() const { return m_books; }
+
+    /**
+     * @brief Immutable copy of the collection shared between readers
+     */
+    using Snapshot = std::shared_ptr<const std::vector<Book>>;
+
+    /**
+     * @brief Get an immutable snapshot of the collection
+     * Points into getReadView(), so it costs no copy of its own. Same
+     * threading contract and ordering as getReadView().
+     * @return Snapshot of the current version
+     */
+    Snapshot getSnapshot() const;
+
+    /**
+     * @brief Immutable copy of the catalog and its indexes, shared between readers
+     * Every const query (findByTitle, findIdsContaining, fuzzySearchByTitle,
+     * completePrefix, QueryEngine, sortIndices, ...) may run on it from any thread while
+     * this manager keeps changing. The undo stack, borrow queue, BST and
+     * graph are not part of the copy.
+     */
+    using ReadView = std::shared_ptr<const BookManager>;
+
+    /**
+     * @brief Get a read-only copy of the current version
+     * The copy (books, ID/secondary/text/genre/range indexes, prefix tries,
+     * aggregates and column store - O(n), strings are shared) is made at
+     * most once per version and shared by every caller. In-place sorts
+     * (quickSortBy*) do not change the version, so the view keeps the book
+     * order of the moment it was copied; read books() for the live order.
+     *
+     * Not thread-safe: the copy is cached in unsynchronized members, so call
+     * this only from the thread that modifies the manager (the GUI thread).
+     * The returned view may then be read from any thread.
+     * @return View of the current version
+     */
+    ReadView getReadView() const;
+
+    /**
+     * @brief Change counter, incremented whenever the content of the collection changes
+     * Adding, updating, removing or loading books bumps it; reordering the
+     * collection in place (quickSortBy*) does not. Starts at 1, so 0 can be
+     * used as "not seen yet".
+     * @return Current version
+     */
+    quint64 getVersion() const { return m_version; }
+
     /**
      * @brief Set books collection (untuk operasi sementara)
+     * Secondary indexes are rebuilt in one pass.
      * @param books Vector of books to set
      */
-    void setBooks(const std::vector<Book>& books) { m_books = books; }
+    void setBooks(const std::vector<Book>& books);
 
     /**
-     * @brief Get book by ID
+     * @brief Get book by ID - O(1) via the ID hash index
+     * Edit the returned book through updateBook() so the secondary indexes stay current.
      * @param id Book ID
      * @return Pointer to book if found, nullptr otherwise
      */
     Book* getBookById(int id);
 
+    /**
+     * @brief Position of a book in books() - O(1) via the ID hash index
+     * @param id Book ID
+     * @return Slot in books(), or kNoSlot if the ID is unknown
+     */
+    uint32_t getSlotById(int id) const { return m_idIndex.find(id); }
+
+    static constexpr uint32_t kNoSlot = IdHashIndex::kNotFound;  ///< Returned by getSlotById() for unknown IDs
+
+    /**
+     * @brief Fixed-point rating key used by every rating index (two decimals: 4.75 -> 475)
+     * Same as Book::ratingKey(); values outside the qint32 range are clamped,
+     * so open bounds can be passed as-is.
+     */
+    static qint32 ratingKey(double rating) { return Book::ratingKey(rating); }
+
     /**
      * @brief Add a new book to the collection
      * @param book Book to add
@@ -92,9 +173,36 @@ class BookManager
     /**
      * @brief Clear all books from collection
      */
-    void clear() { m_books.clear(); }
+    void clear();
 
     // Sorting methods
+    /**
+     * @brief Collections with at least this many books are sorted in parallel
+     */
+    static constexpr size_t kDefaultParallelSortThreshold = 200000;
+
+    /**
+     * @brief Set number of worker threads used by the parallel sort path
+     * @param workers Worker count (0 = all hardware threads, 1 = always single-threaded)
+     */
+    void setSortWorkerCount(int workers) { m_sortWorkers = workers < 0 ? 0 : workers; }
+
+    /**
+     * @brief Get configured sort worker count (0 = all hardware threads)
+     */
+    int getSortWorkerCount() const { return m_sortWorkers; }
+
+    /**
+     * @brief Set minimum collection size for the parallel sort path
+     * @param threshold Number of books at which sorting switches to parallel MergeSort
+     */
+    void setParallelSortThreshold(size_t threshold) { m_parallelSortThreshold = threshold; }
+
+    /**
+     * @brief Get minimum collection size for the parallel sort path
+     */
+    size_t getParallelSortThreshold() const { return m_parallelSortThreshold; }
+
     /**
      * @brief Sort books by title using QuickSort
      * @param ascending True for ascending order, false for descending
@@ -102,13 +210,13 @@ class BookManager
     void quickSortByTitle(bool ascending = true);
 
     /**
-     * @brief Sort books by year using QuickSort
+     * @brief Sort books by year (linear-time counting/radix sort, stable)
      * @param ascending True for ascending order, false for descending
      */
     void quickSortByYear(bool ascending = true);
 
     /**
-     * @brief Sort books by rating using QuickSort
+     * @brief Sort books by rating (radix sort on fixed-point ratings, stable)
      * @param ascending True for ascending order, false for descending
      */
     void quickSortByRating(bool ascending = true);
@@ -119,7 +227,128 @@ class BookManager
      */
     void quickSortByAuthor(bool ascending = true);
 
+    /**
+     * @brief Fields supported by the index-based sort API
+     */
+    enum class SortField { Title, Author, Year, Rating };
+
+    /**
+     * @brief Sort positions into a book store without moving any Book
+     * @param books Book store the indices point into (not modified)
+     * @param indices Positions into books (e.g. filter results), reordered in place
+     * @param field Field to sort by
+     * @param ascending True for ascending order, false for descending
+     * 
+     * Same ordering as the quickSortBy* methods (ties broken by ID, so a
+     * descending sort is the exact reverse of the ascending one), but only
+     * the index vector is rearranged, so a view can switch sort order
+     * without copying the collection. Reads nothing but books and the sort
+     * settings, so it may run on a worker thread over a snapshot.
+     */
+    void sortIndices(const std::vector<Book>& books, std::vector<uint32_t>& indices,
+                     SortField field, bool ascending = true) const;
+
+    /**
+     * @brief Keep only the first k positions in sortIndices() order
+     * @param books Book store the indices point into (not modified)
+     * @param indices Positions into books, shrunk to the first k in sorted order
+     * @param k Number of positions to keep
+     * @param field Field to sort by
+     * @param ascending True for ascending order, false for descending
+     * 
+     * Bounded heap selection over the keys (Sorting::topK): O(n log k)
+     * instead of a full sort, and no Book is copied. Worker-thread safe
+     * like sortIndices().
+     */
+    void topKIndices(const std::vector<Book>& books, std::vector<uint32_t>& indices, size_t k,
+                     SortField field, bool ascending = true) const;
+
+    /**
+     * @brief Get positions of all books in m_books in sorted order
+     * @param field Field to sort by
+     * @param ascending True for ascending order, false for descending
+     * @return Indices into getAllBooks() in sorted order
+     */
+    std::vector<uint32_t> getSortedIndices(SortField field, bool ascending = true) const;
+
+    /**
+     * @brief Get the persistent sorted index for a field
+     * Maintained incrementally by every add/remove/update, so it is always
+     * in the same order as sortIndices(). Walk it forward for ascending
+     * order and backward (rbegin/forEachId(false, ...)) for descending.
+     * @param field Field the index is ordered by
+     * @return Index of (key, book ID) entries
+     */
+    const SecondaryIndex& getSecondaryIndex(SortField field) const
+    {
+        return m_secondaryIndexes[static_cast<int>(field)];
+    }
+
     // Searching methods
+    /**
+     * @brief Find books whose title (and optionally author) contains a fragment
+     * Case-insensitive; answered by the trigram indexes, so the cost follows
+     * the number of candidates instead of the catalog size.
+     * @param fragment Text to look for
+     * @param includeAuthor Also match against the author
+     * @return Matching book IDs in ascending order
+     */
+    std::vector<int> findIdsContaining(const QString& fragment, bool includeAuthor = false) const;
+
+    /**
+     * @brief Keep only the candidates whose title (and optionally author) contain a fragment
+     * Checks the folded texts stored by the trigram indexes, so the cost is
+     * O(candidates) - used to narrow earlier results while the user types.
+     * @param candidates Book IDs to filter (order is kept)
+     * @param fragment Text to look for
+     * @param includeAuthor Also match against the author
+     * @return Candidates that still match
+     */
+    std::vector<int> refineIdsContaining(const std::vector<int>& candidates, const QString& fragment,
+                                         bool includeAuthor = false) const;
+
+    /**
+     * @brief Check one book against a substring predicate without folding again
+     * @param id Book ID
+     * @param foldedFragment Fragment already lowercased by the caller
+     * @param includeAuthor Also match against the author
+     */
+    bool matchesText(int id, const QString& foldedFragment, bool includeAuthor = false) const;
+
+    /**
+     * @brief Upper bound on the number of findIdsContaining() hits, without running it
+     * Cheap (one hash lookup per gram); used to order query predicates by selectivity.
+     */
+    size_t estimateIdsContaining(const QString& fragment, bool includeAuthor = false) const;
+
+    /**
+     * @brief Find book by exact title (case-insensitive) - O(log n) via the title index
+     * @param title Title to look for
+     * @return Book with the lowest ID among equal titles, nullptr if not found
+     */
+    const Book* findByTitle(const QString& title) const;
+
+    /**
+     * @brief Autocomplete titles and authors starting with a prefix
+     * Answered by the prefix tries: ranked by the best rating among books
+     * sharing a completion, in time proportional to prefix length and limit.
+     * @param prefix Typed text (case-insensitive)
+     * @param limit Maximum number of suggestions
+     * @return Distinct titles/authors in their original spelling, best rated first
+     */
+    QStringList completePrefix(const QString& prefix, int limit = 8) const;
+
+    /**
+     * @brief Typo-tolerant title search (e.g. "Laskar Pelngi" -> "Laskar Pelangi")
+     * Candidates come from the title trigram index (q-gram filter) and are
+     * verified with Myers' bit-parallel edit distance.
+     * @param title Title as typed (case-insensitive)
+     * @param maxDistance Largest accepted Levenshtein distance to the whole title
+     * @param limit Maximum number of results (0 = no limit)
+     * @return Books ranked by distance, then rating (highest first), then ID
+     */
+    std::vector<Book> fuzzySearchByTitle(const QString& title, int maxDistance = 2, size_t limit = 20) const;
+
     /**
      * @brief Binary search for book by title (requires sorted data)
      * @param title Title to search for
@@ -128,27 +357,127 @@ class BookManager
     Book* binarySearchByTitle(const QString& title);
 
     /**
-     * @brief Linear search for books by genre
-     * @param genre Genre to search for
-     * @return Vector of books with matching genre
+     * @brief Search books by genre via the genre bitmap index
+     * @param genre Genre to search for (case-insensitive, exact after Book::genreKey())
+     * @return Vector of books with matching genre, in collection order
      */
     std::vector<Book> searchByGenre(const QString& genre) const;
 
     /**
-     * @brief Linear search for books by author
+     * @brief Search books by several genres at once
+     * @param genres Genres to combine
+     * @param matchAll True = books having every genre (AND), false = any of them (OR)
+     * @return Matching books in collection order
+     */
+    std::vector<Book> searchByGenres(const QStringList& genres, bool matchAll) const;
+
+    /**
+     * @brief IDs of the books having a genre - O(1) lookup, maintained on every change
+     * @param genre Genre (normalized with Book::genreKey(), so case and surrounding spaces are ignored)
+     * @return Bitmap of book IDs, nullptr if no book has the genre
+     */
+    const RoaringBitmap* getGenreBitmap(const QString& genre) const;
+
+    /**
+     * @brief Combine genre bitmaps with AND (matchAll) or OR
+     * @return Bitmap of matching book IDs
+     */
+    RoaringBitmap getGenresBitmap(const QStringList& genres, bool matchAll) const;
+
+    /**
+     * @brief Number of books having a genre (popcount of its bitmap)
+     */
+    size_t countByGenre(const QString& genre) const;
+
+    /**
+     * @brief Sorted (year, book ID) index, maintained on every change
+     */
+    const RangeIndex& getYearIndex() const { return m_yearIndex; }
+
+    /**
+     * @brief Sorted (ratingKey(), book ID) index, maintained on every change
+     */
+    const RangeIndex& getRatingIndex() const { return m_ratingIndex; }
+
+    /**
+     * @brief Catalog aggregates (counts, histograms, rating sum), maintained on every change - O(1) to read
+     */
+    const CatalogStats& getStats() const { return m_stats; }
+
+    /**
+     * @brief Columnar copy of the scan fields, slot-aligned with books()
+     */
+    const BookStore& getBookStore() const { return m_store; }
+
+    /**
+     * @brief Default aggregate mode: exact, or sketches when built with PERPUSTAKAAN_SKETCH_STATS
+     */
+#ifdef PERPUSTAKAAN_SKETCH_STATS
+    static constexpr CatalogStats::Mode kDefaultStatsMode = CatalogStats::Mode::Sketch;
+#else
+    static constexpr CatalogStats::Mode kDefaultStatsMode = CatalogStats::Mode::Exact;
+#endif
+
+    /**
+     * @brief Switch between exact and sketch-based aggregates (recounts the catalog once)
+     * @param mode Exact maps, or fixed-memory sketches for very large catalogs
+     */
+    void setStatsMode(CatalogStats::Mode mode);
+
+    /**
+     * @brief Get the aggregate mode in use
+     */
+    CatalogStats::Mode getStatsMode() const { return m_stats.mode(); }
+
+    /**
+     * @brief Search books whose author contains a fragment (case-insensitive)
      * @param author Author to search for
-     * @return Vector of books by the author
+     * @return Vector of books by the author, in collection order
      */
     std::vector<Book> searchByAuthor(const QString& author) const;
 
     /**
      * @brief Search books by year range
+     * Two binary searches in the sorted year index, then only the hits are copied.
      * @param minYear Minimum year
      * @param maxYear Maximum year
-     * @return Vector of books within the year range
+     * @return Vector of books within the year range (collection order)
      */
     std::vector<Book> searchByYearRange(int minYear, int maxYear) const;
 
+    /**
+     * @brief Search books by rating range (bounds compared at two decimals, see ratingKey())
+     * @param minRating Minimum rating (inclusive)
+     * @param maxRating Maximum rating (inclusive)
+     * @return Vector of books within the rating range (collection order)
+     */
+    std::vector<Book> searchByRatingRange(double minRating, double maxRating) const;
+
+    /**
+     * @brief Books with minYear <= year <= maxYear as a view of the year index - O(log n), no copy
+     * Entries are (year, book ID), ascending by year; the view is invalidated by any change.
+     */
+    RangeIndex::View yearRange(int minYear, int maxYear) const { return m_yearIndex.range(minYear, maxYear); }
+
+    /**
+     * @brief Books with minRating <= rating <= maxRating as a view of the rating index - O(log n), no copy
+     * Entries are (ratingKey(), book ID), ascending by rating; the view is invalidated by any change.
+     */
+    RangeIndex::View ratingRange(double minRating, double maxRating) const
+    {
+        return m_ratingIndex.range(ratingKey(minRating), ratingKey(maxRating));
+    }
+
+    /**
+     * @brief Number of books within a year range - O(log n)
+     */
+    size_t countByYearRange(int minYear, int maxYear) const { return yearRange(minYear, maxYear).size(); }
+
+    /**
+     * @brief Number of books within a rating range - O(log n)
+     */
+    size_t countByRatingRange(double minRating, double maxRating) const { return ratingRange(minRating, maxRating).size(); }
+
     /**
      * @brief Get all unique genres from all books
      * @return Vector of unique genre names
@@ -243,49 +572,62 @@ class BookManager
     // ============================================================================
     
     /**
-     * @brief Get top N books by rating using priority queue (Max Heap)
+     * @brief Get top N books by rating
+     * Read straight off the rating index, which every add/update/remove keeps
+     * sorted, so only the N result books are touched and copied - O(N).
      * @param topN Number of top books to retrieve
-     * @return Vector of top rated books
+     * @return Vector of top rated books, highest rating first (ties: lower ID first)
      */
-    std::vector<Book> getTopRatedBooks(int topN = 5);
+    std::vector<Book> getTopRatedBooks(int topN = 5) const;
     
     /**
      * @brief Get books with rating above threshold
+     * Walks the sorted rating index backwards from the top, so only the
+     * books above the threshold are touched - O(log n + k).
+     * @param minRating Minimum rating threshold
+     * @return Vector of books with rating >= minRating, highest rating first (ties: lower ID first)
+     */
+    std::vector<Book> getPopularBooks(double minRating = 4.5) const;
+
+    /**
+     * @brief One page of the books with rating >= minRating, best first
+     * The offset-th best entry is located by rank in the rating index, so a
+     * page costs O(log n + limit) wherever it starts.
      * @param minRating Minimum rating threshold
-     * @return Vector of books with rating >= minRating
+     * @param offset Number of best books to skip
+     * @param limit Page size (0 = everything after offset)
+     * @return Books in the same order as getPopularBooks(minRating)
+     */
+    std::vector<Book> getPopularBooks(double minRating, size_t offset, size_t limit) const;
+
+    /**
+     * @brief Number of books with rating >= minRating - O(log n)
      */
-    std::vector<Book> getPopularBooks(double minRating = 4.5);
+    size_t countPopularBooks(double minRating) const { return m_ratingIndex.countAtLeast(ratingKey(minRating)); }
 
     // ============================================================================
     // BINARY SEARCH TREE - Catalog Structure (Optional)
     // ============================================================================
     
-    /**
-     * @brief Node structure for BST
-     */
-    struct BSTNode {
-        Book book;
-        std::shared_ptr<BSTNode> left;
-        std::shared_ptr<BSTNode> right;
-        
-        BSTNode(const Book& b) : book(b), left(nullptr), right(nullptr) {}
-    };
-    
     /**
      * @brief Build BST from current books (sorted by title)
+     * Balanced (AVL) tree in a node arena, keyed by lowercased title;
+     * books with a duplicate title are skipped. Bulk-loaded in O(n) from
+     * the title secondary index, which is already sorted.
      */
     void buildBST();
     
     /**
-     * @brief Search book in BST by title (exact match)
+     * @brief Search book in BST by title (exact match, case-insensitive)
      * @param title Title to search
-     * @return Pointer to book if found, nullptr otherwise
+     * @return Pointer to book if found (valid until the next buildBST), nullptr otherwise
      */
     Book* searchBST(const QString& title);
     
     /**
      * @brief Search books in BST by partial title (flexible, case-insensitive)
-     * Uses in-order traversal to find all books that match the partial title
+     * Candidates come from the title trigram index; results are the BST's
+     * books in in-order (title) order
      * @param partialTitle Partial title to search (can be lowercase, uppercase, or incomplete)
      * @return Vector of books that match the partial title
      */
@@ -301,12 +643,12 @@ class BookManager
      * @brief Check if BST is built
      * @return true if BST exists
      */
-    bool hasBST() const { return m_bstRoot != nullptr; }
+    bool hasBST() const { return !m_bst.empty(); }
     
     /**
      * @brief Clear BST
      */
-    void clearBST() { m_bstRoot = nullptr; }
+    void clearBST() { m_bst.clear(); }
 
     // ============================================================================
     // GRAPH - Book Recommendation System
@@ -340,50 +682,156 @@ class BookManager
 
 private:
     std::vector<Book> m_books;  ///< Collection of books
+    IdHashIndex m_idIndex;      ///< Book ID -> slot in m_books (rebuilt after sorts)
     
-    // Stack for undo deletion (LIFO)
-    std::stack<Book> m_deletedBooks;
-    
-    // Queue for borrowing requests (FIFO)
-    std::queue<BorrowRequest> m_borrowQueue;
-    
-    // Binary Search Tree root
-    std::shared_ptr<BSTNode> m_bstRoot;
-    
-    // Graph for book recommendations
-    Graph m_graph;
+    // Versioning for zero-copy readers
+    quint64 m_version;                 ///< Incremented on every content change to m_books
+    mutable ReadView m_readView;       ///< Cached read-only copy (shared by all readers)
+    mutable quint64 m_readViewVersion; ///< Version m_readView was taken at
+
+    struct CatalogOnly {};
 
-    // BST helper functions
     /**
-     * @brief Insert node into BST recursively
-     * @param node Current node
-     * @param book Book to insert
-     * @return New node pointer
+     * @brief Copy the books, indexes and settings of another manager (used by getReadView())
      */
-    std::shared_ptr<BSTNode> insertBST(std::shared_ptr<BSTNode> node, const Book& book);
-    
+    BookManager(const BookManager& other, CatalogOnly);
+
     /**
-     * @brief Search in BST recursively (exact match)
-     * @param node Current node
-     * @param title Title to search
-     * @return Pointer to book if found, nullptr otherwise
+     * @brief Record a content change to m_books (invalidates the cached read view)
+     * Not called for pure reorders: a view keeps a consistent copy of its own.
      */
-    Book* searchBSTHelper(std::shared_ptr<BSTNode> node, const QString& title);
-    
+    void markChanged()
+    {
+        m_version++;
+        if (m_stats.needsRebuild()) rebuildStats();
+    }
+
     /**
-     * @brief Search in BST recursively with partial match (flexible)
-     * @param node Current node
-     * @param partialTitle Partial title to search
-     * @param results Vector to store matching books
+     * @brief Recount every book into the aggregates - O(n)
      */
-    void searchBSTPartialHelper(std::shared_ptr<BSTNode> node, const QString& partialTitle, std::vector<Book>& results);
+    void rebuildStats();
     
+    // Parallel sort settings
+    int m_sortWorkers;               ///< Worker threads for large sorts (0 = hardware threads)
+    size_t m_parallelSortThreshold;  ///< Collection size at which sorting goes parallel
+
+    /**
+     * @brief Sort a vector with the configured sort policy
+     * Uses QuickSort for normal collections and parallel MergeSort once the
+     * collection reaches m_parallelSortThreshold and more than one worker is
+     * available. Comparators break ties by ID, so both paths produce the
+     * same order on every run.
+     * @param items Vector to sort (m_books or decorated keys)
+     * @param compare Strict weak ordering on the elements
+     */
+    template<typename T, typename Compare>
+    void sortItems(std::vector<T>& items, Compare compare) const;
+
+    /**
+     * @brief Sort m_books by a key computed once per book (decorate - sort - undecorate)
+     * @param getKey Key extractor
+     * @param compareKeys Strict weak ordering on keys
+     */
+    template<typename KeyFn, typename KeyCompare>
+    void sortBooksByKey(KeyFn getKey, KeyCompare compareKeys);
+
+    /**
+     * @brief Move m_books and the column store into the order of sorted keys, then re-slot the ID index
+     * @param keys Sorted decorated keys (keys[i].index = old slot of new slot i)
+     */
+    template<typename K>
+    void applySortedKeys(const std::vector<Sorting::KeyedIndex<K>>& keys);
+
+    /**
+     * @brief Sort positions into books by a key computed once per position
+     * @param books Book store the indices point into
+     * @param indices Positions to sort in place
+     * @param getKey Key extractor
+     * @param compareKeys Strict weak ordering on keys
+     */
+    template<typename KeyFn, typename KeyCompare>
+    void sortIndicesByKey(const std::vector<Book>& books, std::vector<uint32_t>& indices,
+                          KeyFn getKey, KeyCompare compareKeys) const;
+
+    // Secondary indexes (one per SortField), keyed by book ID
+    static constexpr int kSortFieldCount = 4;
+    SecondaryIndex m_secondaryIndexes[kSortFieldCount];
+
+    // Substring indexes, keyed by book ID
+    TrigramIndex m_titleTrigrams;
+    TrigramIndex m_authorTrigrams;
+
+    // Autocomplete tries over folded titles/authors, scored by fixed-point rating
+    PrefixTrie m_titleTrie;
+    PrefixTrie m_authorTrie;
+
+    // Inverted genre index: folded genre -> bitmap of book IDs
+    QHash<QString, RoaringBitmap> m_genreIndex;
+
+    // Sorted block arrays for range counting, rank and range scans
+    RangeIndex m_yearIndex;
+    RangeIndex m_ratingIndex;
+
+    // Aggregates for the dashboard and statistics pages
+    CatalogStats m_stats;
+
+    // Struct-of-arrays copy of m_books for field scans (same slots)
+    BookStore m_store;
+
+    /**
+     * @brief Books whose IDs are in a bitmap, in m_books order
+     */
+    std::vector<Book> booksInBitmap(const RoaringBitmap& ids) const;
+
+    /**
+     * @brief Books in a range index view, in m_books order
+     */
+    std::vector<Book> booksInRange(const RangeIndex::View& range) const;
+
     /**
-     * @brief In-order traversal of BST
-     * @param node Current node
-     * @param result Result vector to fill
+     * @brief Copy the books at the given slots, in m_books order (slots are sorted here)
      */
-    void inOrderTraversal(std::shared_ptr<BSTNode> node, std::vector<Book>& result);
+    std::vector<Book> booksAtSlots(std::vector<uint32_t>& slots) const;
+
+    /**
+     * @brief Books with rating key >= minKey, rating descending then ID ascending
+     * @param minKey Lowest ratingKey() to include
+     * @param offset Number of leading books to skip
+     * @param limit Maximum number of books (0 = no limit)
+     */
+    std::vector<Book> booksByRatingDesc(qint32 minKey, size_t offset, size_t limit) const;
+
+    /**
+     * @brief Add one book to every secondary, text, genre and range index - O(log n + text length)
+     */
+    void indexBook(const Book& book);
+
+    /**
+     * @brief Remove one book from every secondary, text, genre and range index
+     */
+    void unindexBook(const Book& book);
+
+    /**
+     * @brief Rebuild the ID hash index after m_books was reordered
+     */
+    void rebuildIdIndex();
+
+    /**
+     * @brief Rebuild the ID hash index, column store and every secondary index from m_books
+     */
+    void rebuildIndexes();
+
+    // Stack for undo deletion (LIFO)
+    std::stack<Book> m_deletedBooks;
+    
+    // Queue for borrowing requests (FIFO)
+    std::queue<BorrowRequest> m_borrowQueue;
+    
+    // Binary Search Tree (balanced, arena-allocated)
+    BalancedBST m_bst;
+    
+    // Graph for book recommendations
+    Graph m_graph;
 };
 
 #endif // BOOKMANAGER_H
@@ -0,0 +1,181 @@
+#ifndef BOOKSTORE_H
+#define BOOKSTORE_H
+
+#include "Book.h"
+#include "Sorting.h"
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QtGlobal>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Columnar (struct-of-arrays) copy of the scan-relevant book fields
+ *
+ * A Book keeps its title, author, genres and image path in separate heap
+ * blocks, so a loop that only needs years or ratings still drags whole
+ * records (and pointer chases) through the cache. BookStore keeps one
+ * contiguous column per field, aligned slot for slot with
+ * BookManager::books(): 4-byte IDs, 4-byte years, 4-byte fixed-point
+ * ratings (Book::ratingKey(), the same keys as the rating index) and a
+ * 64-bit genre mask. A year + rating filter then streams 8 bytes per book
+ * instead of touching a ~200-byte Book.
+ *
+ * Genres are interned as Book::genreKey() (like the genre index); the
+ * first 63 distinct genres get their own mask bit and bit 63 marks "some
+ * genre without a bit". Text predicates stay with the trigram indexes.
+ */
+class BookStore
+{
+public:
+    static constexpr uint64_t kOverflowGenre = uint64_t(1) << 63;
+
+    /**
+     * @brief Append a book (new last slot)
+     */
+    void push_back(const Book& book)
+    {
+        m_ids.push_back(book.getId());
+        m_years.push_back(book.getTahun());
+        m_ratings.push_back(Book::ratingKey(book.getRating()));
+        m_genreMasks.push_back(genreMaskOf(book.getGenre()));
+    }
+
+    /**
+     * @brief Overwrite one slot with a book's current fields
+     */
+    void set(size_t slot, const Book& book)
+    {
+        m_ids[slot] = book.getId();
+        m_years[slot] = book.getTahun();
+        m_ratings[slot] = Book::ratingKey(book.getRating());
+        m_genreMasks[slot] = genreMaskOf(book.getGenre());
+    }
+
+    /**
+     * @brief Remove one slot; later slots move down by one (like vector::erase)
+     */
+    void erase(size_t slot)
+    {
+        m_ids.erase(m_ids.begin() + slot);
+        m_years.erase(m_years.begin() + slot);
+        m_ratings.erase(m_ratings.begin() + slot);
+        m_genreMasks.erase(m_genreMasks.begin() + slot);
+    }
+
+    /**
+     * @brief Reorder every column the way Sorting::undecorate() reorders the books - O(n)
+     * Only the fixed-width values move; the genre bits stay as they are.
+     * @param keys Sorted decorated keys: keys[i].index is the old slot of new slot i
+     */
+    template<typename K>
+    void permute(const std::vector<Sorting::KeyedIndex<K>>& keys)
+    {
+        permuteColumn(m_ids, keys);
+        permuteColumn(m_years, keys);
+        permuteColumn(m_ratings, keys);
+        permuteColumn(m_genreMasks, keys);
+    }
+
+    /**
+     * @brief Rebuild every column from the books, in order (also drops unused genre bits)
+     */
+    void assign(const std::vector<Book>& books)
+    {
+        clear();
+        reserve(books.size());
+        for (const Book& book : books) push_back(book);
+    }
+
+    void clear()
+    {
+        m_ids.clear();
+        m_years.clear();
+        m_ratings.clear();
+        m_genreMasks.clear();
+        m_genreBits.clear();
+    }
+
+    void reserve(size_t count)
+    {
+        m_ids.reserve(count);
+        m_years.reserve(count);
+        m_ratings.reserve(count);
+        m_genreMasks.reserve(count);
+    }
+
+    size_t size() const { return m_ids.size(); }
+    bool empty() const { return m_ids.empty(); }
+
+    // Column access (slot-aligned with BookManager::books())
+    const std::vector<qint32>& ids() const { return m_ids; }
+    const std::vector<qint32>& years() const { return m_years; }
+    const std::vector<qint32>& ratings() const { return m_ratings; }
+    const std::vector<uint64_t>& genreMasks() const { return m_genreMasks; }
+
+    int id(size_t slot) const { return m_ids[slot]; }
+    int year(size_t slot) const { return m_years[slot]; }
+
+    /**
+     * @brief Rating of a slot as Book::ratingKey() (hundredths)
+     */
+    qint32 ratingKey(size_t slot) const { return m_ratings[slot]; }
+
+    /**
+     * @brief Mask bit of a genre (normalized with Book::genreKey())
+     * @return The bit, or 0 if the genre was never stored or has no bit of its own
+     */
+    uint64_t genreBit(const QString& genre) const
+    {
+        auto it = m_genreBits.constFind(Book::genreKey(genre));
+        if (it == m_genreBits.constEnd() || it.value() == kOverflowGenre) return 0;
+        return it.value();
+    }
+
+    /**
+     * @brief Bytes held by the columns
+     */
+    size_t columnBytes() const
+    {
+        return m_ids.size() * (sizeof(qint32) * 3 + sizeof(uint64_t));
+    }
+
+private:
+    static constexpr int kGenreBits = 63;
+
+    std::vector<qint32> m_ids;
+    std::vector<qint32> m_years;
+    std::vector<qint32> m_ratings;       ///< Book::ratingKey(), hundredths of a star
+    std::vector<uint64_t> m_genreMasks;  ///< One bit per interned genre
+    QHash<QString, uint64_t> m_genreBits;  ///< Book::genreKey() -> mask bit
+
+    template<typename T, typename K>
+    static void permuteColumn(std::vector<T>& column, const std::vector<Sorting::KeyedIndex<K>>& keys)
+    {
+        std::vector<T> result;
+        result.reserve(column.size());
+        for (const Sorting::KeyedIndex<K>& entry : keys) result.push_back(column[entry.index]);
+        column.swap(result);
+    }
+
+    uint64_t genreMaskOf(const QStringList& genres)
+    {
+        uint64_t mask = 0;
+        for (const QString& genre : genres) {
+            QString key = Book::genreKey(genre);
+            auto it = m_genreBits.constFind(key);
+            if (it != m_genreBits.constEnd()) {
+                mask |= it.value();
+                continue;
+            }
+            int assigned = m_genreBits.size();
+            uint64_t bit = assigned < kGenreBits ? uint64_t(1) << assigned : kOverflowGenre;
+            m_genreBits.insert(key, bit);
+            mask |= bit;
+        }
+        return mask;
+    }
+};
+
+#endif // BOOKSTORE_H
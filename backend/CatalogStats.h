@@ -0,0 +1,250 @@
+#ifndef CATALOGSTATS_H
+#define CATALOGSTATS_H
+
+#include "Book.h"
+#include "Sketches.h"
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+#include <map>
+#include <cmath>
+#include <algorithm>
+
+/**
+ * @brief Catalog-wide aggregates kept up to date on every change
+ *
+ * BookManager feeds every added book to add() and every removed (or
+ * replaced) book to remove(), so the dashboard and statistics pages read
+ * counts and histograms in O(1) instead of rescanning the catalog. The
+ * rating sum adds up Book::ratingKey() values (hundredths), the same fixed
+ * point as the rating indexes, so repeated add/remove cycles do not drift
+ * the way a running double sum would. Rating and
+ * decade histograms have a handful of buckets and are always exact.
+ *
+ * Two modes for the per-author and per-genre data:
+ * - Exact: refcounted maps of every author and genre. Distinct counts are
+ *   exact under deletes, memory grows with the number of distinct names.
+ * - Sketch: fixed memory (about 64 KB) for catalogs with tens of millions
+ *   of books. HyperLogLog estimates distinct authors/genres (standard
+ *   error 0.8%); a count-min sketch estimates books per genre (overcount
+ *   at most 0.14% of all genre tags, 98% confidence) and only the
+ *   kTrackedGenres most frequent genres keep their name. HyperLogLog
+ *   cannot forget: after deletes it may also count names whose books are
+ *   all gone, at most one per removal. needsRebuild() asks the owner to
+ *   re-add the catalog once removals pass 1/16 of the books, which caps
+ *   that overcount and costs 16 re-adds per removal amortized.
+ */
+class CatalogStats
+{
+public:
+    enum class Mode { Exact, Sketch };
+
+    static constexpr size_t kTrackedGenres = 64;  ///< Genre names kept in sketch mode
+
+    explicit CatalogStats(Mode mode = Mode::Exact) : m_mode(mode) {}
+
+    /**
+     * @brief Switch mode; drops everything, so re-add the catalog afterwards
+     */
+    void setMode(Mode mode)
+    {
+        m_mode = mode;
+        clear();
+    }
+
+    Mode mode() const { return m_mode; }
+
+    /**
+     * @brief Count one book in every aggregate - O(log k + genres)
+     */
+    void add(const Book& book)
+    {
+        m_bookCount++;
+        m_ratingSum += Book::ratingKey(book.getRating());
+        m_ratingHistogram[ratingBucket(book.getRating())]++;
+        m_decadeHistogram[decadeOf(book.getTahun())]++;
+        if (m_mode == Mode::Exact) {
+            m_authorCounts[book.getPenulis()]++;
+            for (const QString& genre : book.getGenre()) m_genreCounts[genre.trimmed()]++;
+            return;
+        }
+        m_authorSketch.add(book.getPenulis());
+        for (const QString& genre : book.getGenre()) {
+            QString name = genre.trimmed();
+            m_genreSketch.add(name);
+            m_genreNames.add(name);
+            trackGenre(name);
+        }
+    }
+
+    /**
+     * @brief Take back a book counted by add() (pass the same field values)
+     */
+    void remove(const Book& book)
+    {
+        if (m_bookCount == 0) return;
+        m_bookCount--;
+        m_ratingSum -= Book::ratingKey(book.getRating());
+        decrement(m_ratingHistogram, ratingBucket(book.getRating()));
+        decrement(m_decadeHistogram, decadeOf(book.getTahun()));
+        if (m_mode == Mode::Exact) {
+            decrement(m_authorCounts, book.getPenulis());
+            for (const QString& genre : book.getGenre()) decrement(m_genreCounts, genre.trimmed());
+            return;
+        }
+        m_removedSinceClear++;
+        for (const QString& genre : book.getGenre()) {
+            QString name = genre.trimmed();
+            m_genreSketch.add(name, -1);
+            auto it = m_genreCounts.find(name);
+            if (it == m_genreCounts.end()) continue;
+            it->second = m_genreSketch.estimate(name);
+            if (it->second <= 0) m_genreCounts.erase(it);
+        }
+    }
+
+    void clear()
+    {
+        m_bookCount = 0;
+        m_ratingSum = 0;
+        m_authorCounts.clear();
+        m_genreCounts.clear();
+        m_ratingHistogram.clear();
+        m_decadeHistogram.clear();
+        m_authorSketch.clear();
+        m_genreNames.clear();
+        m_genreSketch.clear();
+        m_removedSinceClear = 0;
+    }
+
+    /**
+     * @brief Whether removals have made the sketches stale enough to re-add the catalog
+     * Always false in exact mode.
+     */
+    bool needsRebuild() const
+    {
+        return m_mode == Mode::Sketch && m_removedSinceClear > kRebuildMinimum
+            && m_removedSinceClear * kRebuildDivisor > m_bookCount;
+    }
+
+    size_t bookCount() const { return m_bookCount; }
+
+    /**
+     * @brief Distinct authors (estimated in sketch mode)
+     */
+    size_t authorCount() const
+    {
+        return m_mode == Mode::Exact ? m_authorCounts.size() : roundedEstimate(m_authorSketch);
+    }
+
+    /**
+     * @brief Distinct genres (estimated in sketch mode)
+     */
+    size_t genreCount() const
+    {
+        return m_mode == Mode::Exact ? m_genreCounts.size() : roundedEstimate(m_genreNames);
+    }
+
+    /**
+     * @brief Sum of all ratings (to 2 decimals)
+     */
+    double ratingSum() const { return static_cast<double>(m_ratingSum) / Book::kRatingScale; }
+
+    /**
+     * @brief Average rating, 0.0 for an empty catalog
+     */
+    double averageRating() const { return m_bookCount > 0 ? ratingSum() / m_bookCount : 0.0; }
+
+    /**
+     * @brief Books per genre (trimmed genre name -> count), sorted by name
+     * Sketch mode: only the most frequent genres, with count-min estimates.
+     */
+    const std::map<QString, int>& genreCounts() const { return m_genreCounts; }
+
+    /**
+     * @brief Books per whole-star rating (0..5 -> count)
+     */
+    const std::map<int, int>& ratingHistogram() const { return m_ratingHistogram; }
+
+    /**
+     * @brief Books per publication decade (1990, 2000, ... -> count)
+     */
+    const std::map<int, int>& decadeHistogram() const { return m_decadeHistogram; }
+
+    /**
+     * @brief Number of books in one whole-star rating bucket
+     */
+    int ratingBucketCount(int stars) const
+    {
+        auto it = m_ratingHistogram.find(stars);
+        return it != m_ratingHistogram.end() ? it->second : 0;
+    }
+
+    /**
+     * @brief Relative standard error of authorCount()/genreCount() (0 in exact mode)
+     */
+    double distinctError() const { return m_mode == Mode::Exact ? 0.0 : m_authorSketch.standardError(); }
+
+    /**
+     * @brief Largest expected overcount of a genreCounts() value (0 in exact mode)
+     */
+    double genreCountError() const { return m_mode == Mode::Exact ? 0.0 : m_genreSketch.errorBound(); }
+
+    static int ratingBucket(double rating) { return static_cast<int>(rating); }
+    static int decadeOf(int year) { return (year / 10) * 10; }
+
+private:
+    static constexpr size_t kRebuildMinimum = 1024;  ///< Never rebuild for a few removals
+    static constexpr size_t kRebuildDivisor = 16;    ///< Rebuild once removals exceed bookCount / 16
+
+    Mode m_mode;
+    size_t m_bookCount = 0;
+    qint64 m_ratingSum = 0;                  ///< Sum of Book::ratingKey() (hundredths)
+    std::map<QString, int> m_authorCounts;   ///< Author -> books (exact mode)
+    std::map<QString, int> m_genreCounts;    ///< Trimmed genre -> books (sketch: top genres only)
+    std::map<int, int> m_ratingHistogram;    ///< Whole stars -> books
+    std::map<int, int> m_decadeHistogram;    ///< Decade -> books
+
+    // Sketch mode
+    HyperLogLog m_authorSketch;
+    HyperLogLog m_genreNames;
+    CountMinSketch m_genreSketch;
+    size_t m_removedSinceClear = 0;
+
+    static size_t roundedEstimate(const HyperLogLog& sketch) { return static_cast<size_t>(std::llround(sketch.estimate())); }
+
+    /**
+     * @brief Keep a genre among the named ones if it is now one of the most frequent
+     * The least frequent tracked genre is evicted once the table is full.
+     */
+    void trackGenre(const QString& name)
+    {
+        int estimate = m_genreSketch.estimate(name);
+        auto it = m_genreCounts.find(name);
+        if (it != m_genreCounts.end()) {
+            it->second = estimate;
+            return;
+        }
+        if (m_genreCounts.size() < kTrackedGenres) {
+            m_genreCounts.emplace(name, estimate);
+            return;
+        }
+        auto weakest = std::min_element(m_genreCounts.begin(), m_genreCounts.end(),
+                                        [](const std::pair<const QString, int>& a, const std::pair<const QString, int>& b) {
+                                            return a.second < b.second;
+                                        });
+        if (weakest->second >= estimate) return;
+        m_genreCounts.erase(weakest);
+        m_genreCounts.emplace(name, estimate);
+    }
+
+    template<typename Key>
+    static void decrement(std::map<Key, int>& counts, const Key& key)
+    {
+        auto it = counts.find(key);
+        if (it == counts.end()) return;
+        if (--it->second <= 0) counts.erase(it);
+    }
+};
+
+#endif // CATALOGSTATS_H
@@ -96,6 +96,19 @@ void DatabaseManager::close()
 }
 
 bool DatabaseManager::addBook(const Book& book)
+{
+    if (!insertBookRow(book)) {
+        return false;
+    }
+    
+    // Keep BookManager (and its sorted indexes) in step with the database
+    m_bookManager.addBook(book);
+    
+    qDebug() << "Book added successfully:" << book.getJudul();
+    return true;
+}
+
+bool DatabaseManager::insertBookRow(const Book& book)
 {
     QSqlQuery query;
     query.prepare(R"(
@@ -116,7 +129,6 @@ bool DatabaseManager::addBook(const Book& book)
         return false;
     }
     
-    qDebug() << "Book added successfully:" << book.getJudul();
     return true;
 }
 
@@ -143,21 +155,14 @@ bool DatabaseManager::updateBook(const Book& book)
         return false;
     }
     
+    m_bookManager.updateBook(book);
+    
     qDebug() << "Book updated successfully:" << book.getJudul();
     return true;
 }
 
 bool DatabaseManager::deleteBook(int id)
 {
-    // IMPORTANT: Sync BookManager first to ensure it has the latest data
-    syncBookManager();
-    
-    // Save to undo stack in BookManager before deleting from database
-    // This allows the undo functionality to work properly (Stack - LIFO)
-    if (m_bookManager.removeBook(id)) {
-        qDebug() << "Book saved to undo stack (Stack - LIFO)";
-    }
-    
     QSqlQuery query;
     query.prepare("DELETE FROM books WHERE id = :id");
     query.bindValue(":id", id);
@@ -167,6 +172,12 @@ bool DatabaseManager::deleteBook(int id)
         return false;
     }
     
+    // Mirror into BookManager only once the row is gone, like addBook/updateBook.
+    // removeBook also saves the book to the undo stack (Stack - LIFO)
+    if (m_bookManager.removeBook(id)) {
+        qDebug() << "Book saved to undo stack (Stack - LIFO)";
+    }
+    
     qDebug() << "Book deleted successfully from database, ID:" << id;
     return true;
 }
@@ -309,35 +320,9 @@ std::vector<Book> DatabaseManager::searchByAuthor(const QString& author)
 
 std::vector<Book> DatabaseManager::searchByGenre(const QString& genre)
 {
-    std::vector<Book> books;
-    
-    QSqlQuery query;
-    query.prepare("SELECT * FROM books WHERE genre LIKE :genre");
-    query.bindValue(":genre", "%" + genre + "%");
-    
-    if (query.exec()) {
-        while (query.next()) {
-            Book book;
-            book.setId(query.value("id").toInt());
-            book.setJudul(query.value("judul").toString());
-            book.setPenulis(query.value("penulis").toString());
-            
-            QString genreStr = query.value("genre").toString();
-            QStringList genres = genreStr.split(",", Qt::SkipEmptyParts);
-            for (QString& g : genres) {
-                g = g.trimmed();
-            }
-            book.setGenre(genres);
-            
-            book.setTahun(query.value("tahun").toInt());
-            book.setRating(query.value("rating").toDouble());
-            book.setImagePath(query.value("imagePath").toString());
-            
-            books.push_back(book);
-        }
-    }
-    
-    return books;
+    // Answered by the in-memory genre bitmap index (kept in sync with the table)
+    // instead of a LIKE '%genre%' scan over the comma-joined genre column
+    return m_bookManager.searchByGenre(genre);
 }
 
 bool DatabaseManager::clearAllBooks()
@@ -451,8 +436,7 @@ bool DatabaseManager::insertSampleBooks()
     
     qDebug() << "Successfully inserted" << inserted << "sample books";
     
-    // Sync with BookManager
-    syncBookManager();
+    // addBook() already mirrors every insert into BookManager
     
     return inserted == sampleBooks.size();
 }
@@ -465,11 +449,7 @@ void DatabaseManager::syncBookManager()
 {
     // Load all books from database to BookManager
     std::vector<Book> books = getAllBooks();
-    m_bookManager.clear();
-    
-    for (const Book& book : books) {
-        m_bookManager.addBook(book);
-    }
+    m_bookManager.setBooks(books);  // Secondary indexes are rebuilt in one pass
     
     qDebug() << "Synced" << books.size() << "books to BookManager";
 }
@@ -482,10 +462,10 @@ bool DatabaseManager::saveBookManagerToDatabase()
     // Clear database
     clearAllBooks();
     
-    // Insert all books from BookManager
+    // Insert all books from BookManager (rows only - they are already in BookManager)
     int saved = 0;
     for (const Book& book : books) {
-        if (addBook(book)) {
+        if (insertBookRow(book)) {
             saved++;
         }
     }
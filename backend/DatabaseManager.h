@@ -39,12 +39,12 @@ class DatabaseManager
 
     // CRUD Operations
     /**
-     * @brief Add a new book to database
+     * @brief Add a new book to database (also added to BookManager)
      */
     bool addBook(const Book& book);
 
     /**
-     * @brief Update existing book
+     * @brief Update existing book (also updated in BookManager)
      */
     bool updateBook(const Book& book);
 
@@ -126,6 +126,11 @@ class DatabaseManager
     DatabaseManager& operator=(const DatabaseManager&) = delete;
 
     bool createTables();
+
+    /**
+     * @brief Insert one book row without touching BookManager
+     */
+    bool insertBookRow(const Book& book);
     QSqlDatabase m_database;
     QString m_dbPath;
     BookManager m_bookManager;  ///< BookManager for advanced data structures (Stack, Queue, BST, Priority Queue)
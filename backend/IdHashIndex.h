@@ -0,0 +1,143 @@
+#ifndef IDHASHINDEX_H
+#define IDHASHINDEX_H
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Open-addressing hash map from book ID to slot in the book vector
+ *
+ * Flat table with linear probing and backward-shift deletion (no
+ * tombstones), so lookups stay O(1) on average no matter how many books
+ * were added and removed. Capacity is a power of two and the load factor
+ * is kept at or below 1/2.
+ */
+class IdHashIndex
+{
+public:
+    static constexpr uint32_t kNotFound = 0xFFFFFFFFu;  ///< Returned by find() for unknown IDs
+
+    IdHashIndex() : m_size(0), m_mask(0) {}
+
+    /**
+     * @brief Find the slot of a book
+     * @param id Book ID
+     * @return Slot in the book vector, or kNotFound
+     */
+    uint32_t find(int id) const
+    {
+        if (m_size == 0) return kNotFound;
+        for (size_t i = bucketOf(id); ; i = (i + 1) & m_mask) {
+            const Bucket& bucket = m_buckets[i];
+            if (bucket.slot == kNotFound) return kNotFound;
+            if (bucket.id == id) return bucket.slot;
+        }
+    }
+
+    /**
+     * @brief Insert or overwrite the slot of a book
+     * @param id Book ID
+     * @param slot Slot in the book vector
+     */
+    void set(int id, uint32_t slot)
+    {
+        if ((m_size + 1) * 2 > m_buckets.size()) {
+            grow();
+        }
+        size_t i = bucketOf(id);
+        while (m_buckets[i].slot != kNotFound && m_buckets[i].id != id) {
+            i = (i + 1) & m_mask;
+        }
+        if (m_buckets[i].slot == kNotFound) m_size++;
+        m_buckets[i].id = id;
+        m_buckets[i].slot = slot;
+    }
+
+    /**
+     * @brief Remove a book from the index
+     * Later entries of the probe chain are shifted back into the gap.
+     * @param id Book ID
+     * @return true if the ID was present
+     */
+    bool erase(int id)
+    {
+        if (m_size == 0) return false;
+        size_t i = bucketOf(id);
+        for (; ; i = (i + 1) & m_mask) {
+            if (m_buckets[i].slot == kNotFound) return false;
+            if (m_buckets[i].id == id) break;
+        }
+
+        size_t gap = i;
+        for (size_t j = (gap + 1) & m_mask; m_buckets[j].slot != kNotFound; j = (j + 1) & m_mask) {
+            // Move entry j into the gap unless its home bucket lies cyclically in (gap, j]
+            size_t home = bucketOf(m_buckets[j].id);
+            bool homeInRange = gap <= j ? (home > gap && home <= j) : (home > gap || home <= j);
+            if (!homeInRange) {
+                m_buckets[gap] = m_buckets[j];
+                gap = j;
+            }
+        }
+        m_buckets[gap].slot = kNotFound;
+        m_size--;
+        return true;
+    }
+
+    /**
+     * @brief Remove all entries (keeps the allocated table)
+     */
+    void clear()
+    {
+        for (Bucket& bucket : m_buckets) bucket.slot = kNotFound;
+        m_size = 0;
+    }
+
+    /**
+     * @brief Make room for at least count entries without rehashing
+     */
+    void reserve(size_t count)
+    {
+        size_t capacity = 16;
+        while (capacity < count * 2) capacity <<= 1;
+        if (capacity > m_buckets.size()) rehash(capacity);
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+private:
+    struct Bucket {
+        int id = 0;
+        uint32_t slot = kNotFound;  ///< kNotFound marks an empty bucket
+    };
+
+    std::vector<Bucket> m_buckets;
+    size_t m_size;
+    size_t m_mask;
+
+    size_t bucketOf(int id) const
+    {
+        // Fibonacci hashing: spreads sequential IDs over the whole table
+        uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h >> 32) & m_mask;
+    }
+
+    void grow()
+    {
+        rehash(m_buckets.empty() ? 16 : m_buckets.size() * 2);
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<Bucket> old;
+        old.swap(m_buckets);
+        m_buckets.assign(capacity, Bucket());
+        m_mask = capacity - 1;
+        m_size = 0;
+        for (const Bucket& bucket : old) {
+            if (bucket.slot != kNotFound) set(bucket.id, bucket.slot);
+        }
+    }
+};
+
+#endif // IDHASHINDEX_H
@@ -0,0 +1,339 @@
+#ifndef PREFIXTRIE_H
+#define PREFIXTRIE_H
+
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+#include <queue>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Compressed (radix) prefix trie with top-k completion by score
+ *
+ * Keys are case-folded and stored once: every edge label is a slice of one
+ * shared character pool, and chains of single-child nodes are collapsed
+ * into a single edge. Each node caches the best score found in its
+ * subtree, so complete() walks down the prefix and then expands nodes
+ * best-first, touching roughly limit x branching nodes no matter how many
+ * keys share the prefix.
+ *
+ * Several IDs may share a key (e.g. two books with the same title); a key
+ * is reported once, with its best-scoring ID.
+ */
+class PrefixTrie
+{
+public:
+    /**
+     * @brief One completion: the best-scoring ID stored under a distinct key
+     */
+    struct Completion {
+        int id;
+        qint32 score;
+    };
+
+    PrefixTrie() { clear(); }
+
+    /**
+     * @brief Add an ID under a key - O(key length + branching)
+     * @param key Key text (folded here)
+     * @param id Book ID
+     * @param score Ranking score (higher ranks first)
+     */
+    void insert(const QString& key, int id, qint32 score)
+    {
+        QString folded = key.toLower();
+        std::vector<int32_t> path;
+        int32_t cur = kRoot;
+        int pos = 0;
+
+        while (true) {
+            path.push_back(cur);
+            if (pos == folded.size()) break;
+
+            int32_t child = childStartingWith(cur, folded.at(pos).unicode());
+            if (child == kNull) {
+                // No edge shares the next character: hang the rest of the key here
+                child = newNode(appendLabel(folded, pos), folded.size() - pos);
+                linkChild(cur, child);
+                path.push_back(child);
+                cur = child;
+                break;
+            }
+
+            int common = commonLength(child, folded, pos);
+            if (common < m_nodes[child].labelLength) {
+                // Key leaves the edge halfway: split it at the divergence point
+                int32_t mid = newNode(m_nodes[child].labelStart, common);
+                replaceChild(cur, child, mid);
+                m_nodes[child].labelStart += common;
+                m_nodes[child].labelLength -= common;
+                linkChild(mid, child);
+                m_nodes[mid].best = m_nodes[child].best;
+                child = mid;
+            }
+            cur = child;
+            pos += common;
+        }
+
+        m_nodes[cur].entries.push_back(Completion{id, score});
+        for (int32_t node : path) {
+            if (score > m_nodes[node].best) m_nodes[node].best = score;
+        }
+        m_size++;
+    }
+
+    /**
+     * @brief Remove an ID from a key - O(key length + branching)
+     * Empty leaves are unlinked and single-child nodes are merged back.
+     * @param key Key the ID was inserted under (folded here)
+     * @param id Book ID
+     * @return true if the (key, ID) pair was present
+     */
+    bool erase(const QString& key, int id)
+    {
+        QString folded = key.toLower();
+        std::vector<int32_t> path;
+        int32_t cur = kRoot;
+        int pos = 0;
+
+        path.push_back(cur);
+        while (pos < folded.size()) {
+            int32_t child = childStartingWith(cur, folded.at(pos).unicode());
+            if (child == kNull) return false;
+            int length = m_nodes[child].labelLength;
+            if (commonLength(child, folded, pos) != length) return false;
+            cur = child;
+            pos += length;
+            path.push_back(cur);
+        }
+
+        std::vector<Completion>& entries = m_nodes[cur].entries;
+        size_t i = 0;
+        while (i < entries.size() && entries[i].id != id) i++;
+        if (i == entries.size()) return false;
+        entries[i] = entries.back();
+        entries.pop_back();
+        m_size--;
+
+        // Bottom-up: prune, compact and refresh cached subtree scores
+        for (size_t depth = path.size() - 1; depth > 0; depth--) {
+            int32_t node = path[depth];
+            int32_t parent = path[depth - 1];
+            if (m_nodes[node].entries.empty() && m_nodes[node].firstChild == kNull) {
+                unlinkChild(parent, node);
+                releaseNode(node);
+                continue;
+            }
+            if (m_nodes[node].entries.empty() && m_nodes[m_nodes[node].firstChild].nextSibling == kNull) {
+                mergeWithOnlyChild(node);
+            }
+            refreshBest(node);
+        }
+        refreshBest(kRoot);
+        return true;
+    }
+
+    /**
+     * @brief Best keys starting with a prefix, highest score first
+     * @param prefix Prefix to complete (folded here); empty completes everything
+     * @param limit Maximum number of completions
+     * @return At most limit completions, one per distinct key
+     */
+    std::vector<Completion> complete(const QString& prefix, size_t limit) const
+    {
+        std::vector<Completion> result;
+        if (limit == 0 || m_size == 0) return result;
+
+        QString folded = prefix.toLower();
+        int32_t cur = kRoot;
+        int pos = 0;
+        while (pos < folded.size()) {
+            int32_t child = childStartingWith(cur, folded.at(pos).unicode());
+            if (child == kNull) return result;
+            int common = commonLength(child, folded, pos);
+            // Either the prefix ends inside this edge, or the edge must match fully
+            if (pos + common < folded.size() && common < m_nodes[child].labelLength) return result;
+            cur = child;
+            pos += common;
+        }
+
+        // Best-first expansion: a node is worth at most its cached best score,
+        // so the first `limit` keys popped are exactly the top-k
+        std::priority_queue<Pending> frontier;
+        frontier.push(Pending{m_nodes[cur].best, cur, false});
+        while (!frontier.empty() && result.size() < limit) {
+            Pending top = frontier.top();
+            frontier.pop();
+            const Node& node = m_nodes[top.node];
+            if (top.isKey) {
+                result.push_back(bestEntry(node));
+                continue;
+            }
+            if (!node.entries.empty()) {
+                frontier.push(Pending{bestEntry(node).score, top.node, true});
+            }
+            for (int32_t child = node.firstChild; child != kNull; child = m_nodes[child].nextSibling) {
+                frontier.push(Pending{m_nodes[child].best, child, false});
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Remove everything and release the character pool
+     */
+    void clear()
+    {
+        m_nodes.clear();
+        m_freeNodes.clear();
+        m_pool.clear();
+        m_nodes.push_back(Node(0, 0));
+        m_size = 0;
+    }
+
+    /**
+     * @brief Number of (key, ID) pairs stored
+     */
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+private:
+    static constexpr int32_t kNull = -1;
+    static constexpr int32_t kRoot = 0;
+    static constexpr qint32 kNoScore = std::numeric_limits<qint32>::min();
+
+    struct Node {
+        int32_t labelStart;               ///< Edge label = m_pool[labelStart, labelStart + labelLength)
+        int32_t labelLength;
+        int32_t firstChild;
+        int32_t nextSibling;
+        qint32 best;                      ///< Best score in this subtree (kNoScore when empty)
+        std::vector<Completion> entries;  ///< IDs whose key ends at this node
+
+        Node(int32_t start, int32_t length)
+            : labelStart(start), labelLength(length), firstChild(kNull), nextSibling(kNull), best(kNoScore) {}
+    };
+
+    struct Pending {
+        qint32 score;
+        int32_t node;
+        bool isKey;  ///< true: report this node's key, false: expand its subtree
+
+        bool operator<(const Pending& other) const
+        {
+            if (score != other.score) return score < other.score;
+            return !isKey && other.isKey;  // On ties report keys before expanding
+        }
+    };
+
+    std::vector<Node> m_nodes;         ///< Node arena, node 0 is the root
+    std::vector<int32_t> m_freeNodes;  ///< Released arena slots for reuse
+    std::vector<ushort> m_pool;        ///< Shared storage for edge labels
+    size_t m_size;
+
+    int32_t newNode(int32_t labelStart, int32_t labelLength)
+    {
+        if (!m_freeNodes.empty()) {
+            int32_t node = m_freeNodes.back();
+            m_freeNodes.pop_back();
+            m_nodes[node] = Node(labelStart, labelLength);
+            return node;
+        }
+        m_nodes.push_back(Node(labelStart, labelLength));
+        return static_cast<int32_t>(m_nodes.size() - 1);
+    }
+
+    void releaseNode(int32_t node)
+    {
+        m_nodes[node].entries = std::vector<Completion>();
+        m_freeNodes.push_back(node);
+    }
+
+    int32_t appendLabel(const QString& text, int from)
+    {
+        int32_t start = static_cast<int32_t>(m_pool.size());
+        for (int i = from; i < text.size(); i++) m_pool.push_back(text.at(i).unicode());
+        return start;
+    }
+
+    int32_t childStartingWith(int32_t node, ushort c) const
+    {
+        for (int32_t child = m_nodes[node].firstChild; child != kNull; child = m_nodes[child].nextSibling) {
+            if (m_pool[m_nodes[child].labelStart] == c) return child;
+        }
+        return kNull;
+    }
+
+    /// Number of leading characters the edge into node shares with text[from..]
+    int commonLength(int32_t node, const QString& text, int from) const
+    {
+        const Node& n = m_nodes[node];
+        int limit = std::min<int>(n.labelLength, text.size() - from);
+        int i = 0;
+        while (i < limit && m_pool[n.labelStart + i] == text.at(from + i).unicode()) i++;
+        return i;
+    }
+
+    void linkChild(int32_t parent, int32_t child)
+    {
+        m_nodes[child].nextSibling = m_nodes[parent].firstChild;
+        m_nodes[parent].firstChild = child;
+    }
+
+    void unlinkChild(int32_t parent, int32_t child)
+    {
+        int32_t* link = &m_nodes[parent].firstChild;
+        while (*link != child) link = &m_nodes[*link].nextSibling;
+        *link = m_nodes[child].nextSibling;
+    }
+
+    void replaceChild(int32_t parent, int32_t oldChild, int32_t newChild)
+    {
+        int32_t* link = &m_nodes[parent].firstChild;
+        while (*link != oldChild) link = &m_nodes[*link].nextSibling;
+        *link = newChild;
+        m_nodes[newChild].nextSibling = m_nodes[oldChild].nextSibling;
+        m_nodes[oldChild].nextSibling = kNull;
+    }
+
+    /// Fold the only child of a key-less node into it (label = label + child label)
+    void mergeWithOnlyChild(int32_t node)
+    {
+        int32_t child = m_nodes[node].firstChild;
+        Node& n = m_nodes[node];
+        const Node& c = m_nodes[child];
+        if (n.labelStart + n.labelLength != c.labelStart) {
+            // Labels are not adjacent in the pool: copy both into a fresh slice
+            int32_t start = static_cast<int32_t>(m_pool.size());
+            for (int32_t i = 0; i < n.labelLength; i++) m_pool.push_back(m_pool[n.labelStart + i]);
+            for (int32_t i = 0; i < c.labelLength; i++) m_pool.push_back(m_pool[c.labelStart + i]);
+            n.labelStart = start;
+        }
+        n.labelLength += c.labelLength;
+        n.firstChild = c.firstChild;
+        n.entries.swap(m_nodes[child].entries);
+        releaseNode(child);
+    }
+
+    void refreshBest(int32_t node)
+    {
+        Node& n = m_nodes[node];
+        n.best = n.entries.empty() ? kNoScore : bestEntry(n).score;
+        for (int32_t child = n.firstChild; child != kNull; child = m_nodes[child].nextSibling) {
+            if (m_nodes[child].best > n.best) n.best = m_nodes[child].best;
+        }
+    }
+
+    /// Highest-scoring entry of a node; ties go to the lowest ID
+    static Completion bestEntry(const Node& node)
+    {
+        Completion best = node.entries.front();
+        for (const Completion& entry : node.entries) {
+            if (entry.score > best.score || (entry.score == best.score && entry.id < best.id)) best = entry;
+        }
+        return best;
+    }
+};
+
+#endif // PREFIXTRIE_H
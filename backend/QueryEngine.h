@@ -0,0 +1,307 @@
+#ifndef QUERYENGINE_H
+#define QUERYENGINE_H
+
+#include "BookManager.h"
+#include <QString>
+#include <QStringList>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief Declarative filter + order + limit over the book collection
+ *
+ * Every field is optional; unset fields do not filter. All predicates are
+ * combined with AND.
+ */
+struct BookQuery {
+    QString text;                              ///< Title (and author) must contain this
+    bool textInAuthor = true;                  ///< Also match text against the author
+    const std::vector<int>* candidateIds = nullptr;  ///< Restrict to these IDs (ascending), e.g. search hits
+    QStringList genres;                        ///< Genre names (case-insensitive)
+    bool matchAllGenres = false;               ///< true: every genre (AND), false: any genre (OR)
+    int minYear = std::numeric_limits<int>::min();
+    int maxYear = std::numeric_limits<int>::max();
+    double minRating = std::numeric_limits<double>::lowest();
+    double maxRating = std::numeric_limits<double>::max();
+    bool ordered = false;                      ///< Sort by orderBy; otherwise keep collection order
+    BookManager::SortField orderBy = BookManager::SortField::Title;
+    bool ascending = true;
+    size_t limit = 0;                          ///< Keep only the first limit results (0 = all)
+};
+
+/**
+ * @brief Evaluates a BookQuery against the indexes of a BookManager
+ *
+ * Each predicate has an access path the manager already maintains: the
+ * trigram indexes for text, the genre bitmaps, the sorted year/rating
+ * arrays, and the caller's sorted ID list. Every access path reports how
+ * many books it can produce (exact for genre, ranges and IDs, an upper
+ * bound for text), so the engine enumerates the most selective one and
+ * checks the remaining predicates per book, cheapest filter first.
+ *
+ * Ordered queries with a small limit may instead walk the persistent
+ * secondary index of the sort field and stop after limit hits, so top-k
+ * never materializes (or sorts) the full result; otherwise the matches
+ * go through a bounded heap (BookManager::topKIndices), not a full sort.
+ * Ordered queries without a limit walk the same index when the result is
+ * large (an unfiltered catalog, a broad genre): one O(n) pass in output
+ * order instead of an O(m log m) sort of m matches.
+ *
+ * Per-book checks read the manager's column store (BookStore) rather than
+ * the Book records: year, rating and genre tests are a 4-, 4- and 8-byte
+ * load per candidate.
+ *
+ * Run over a BookManager::getReadView() the engine may live on a worker
+ * thread; the optional cancel check is polled between the filter, sort and
+ * limit stages so a superseded query stops early.
+ */
+class QueryEngine
+{
+public:
+    /**
+     * @brief Create an engine over a book manager
+     * @param manager Manager whose indexes answer the queries (must outlive the engine)
+     */
+    explicit QueryEngine(const BookManager& manager) : m_manager(manager) {}
+
+    /**
+     * @brief Returns true once the caller no longer wants the result
+     */
+    using CancelCheck = std::function<bool()>;
+
+    /**
+     * @brief Run a query
+     * @param query Predicates, order and limit
+     * @param cancelled Polled between stages (empty = never cancelled)
+     * @return Positions in manager.books() of the matching books, in query order;
+     *         empty once cancelled
+     */
+    std::vector<uint32_t> run(const BookQuery& query, const CancelCheck& cancelled = CancelCheck()) const
+    {
+        auto stop = [&]() { return cancelled && cancelled(); };
+        Plan plan = makePlan(query);
+        std::vector<uint32_t> slots;
+        size_t total = m_manager.books().size();
+        if (plan.empty || stop()) return slots;
+
+        // Walking the output order costs about limit x total / matches steps;
+        // take it when that beats enumerating the best predicate
+        size_t driverCost = plan.predicates.empty() ? total : plan.predicates.front().estimate;
+        if (query.limit > 0 && plan.estimate > 0) {
+            double walkCost = static_cast<double>(query.limit) * total / plan.estimate;
+            if (walkCost < driverCost) {
+                walkInOutputOrder(query, plan, slots, cancelled);
+                return stop() ? std::vector<uint32_t>() : slots;
+            }
+        }
+
+        // Without a limit the walk visits every book once; take it when that
+        // beats enumerating the best predicate and sorting what it produced
+        if (query.ordered && query.limit == 0) {
+            double estimate = static_cast<double>(plan.estimate);
+            double sortCost = driverCost + estimate * std::log2(estimate + 1.0);
+            if (static_cast<double>(total) <= sortCost) {
+                walkInOutputOrder(query, plan, slots, cancelled);
+                return stop() ? std::vector<uint32_t>() : slots;
+            }
+        }
+
+        if (plan.predicates.empty()) {
+            slots.resize(total);
+            for (size_t i = 0; i < total; i++) slots[i] = static_cast<uint32_t>(i);
+        } else {
+            enumerateDriver(plan, slots);
+        }
+
+        if (stop()) return std::vector<uint32_t>();
+        if (query.ordered && query.limit > 0) {
+            m_manager.topKIndices(m_manager.books(), slots, query.limit, query.orderBy, query.ascending);
+        } else if (query.ordered) {
+            m_manager.sortIndices(m_manager.books(), slots, query.orderBy, query.ascending);
+        } else if (!std::is_sorted(slots.begin(), slots.end())) {
+            Sorting::quickSort(slots);
+        }
+
+        if (stop()) return std::vector<uint32_t>();
+        if (query.limit > 0 && slots.size() > query.limit) slots.resize(query.limit);
+        return slots;
+    }
+
+    /**
+     * @brief Estimated number of matches without running the query
+     * Exact when the query has a single predicate other than text, otherwise
+     * the smallest predicate cardinality (an upper bound).
+     */
+    size_t estimate(const BookQuery& query) const
+    {
+        Plan plan = makePlan(query);
+        return plan.empty ? 0 : plan.estimate;
+    }
+
+private:
+    enum class Kind { Candidates, Genre, Year, Rating, Text };
+
+    struct Predicate {
+        Kind kind;
+        size_t estimate;  ///< Books this access path would produce
+    };
+
+    struct Plan {
+        const BookQuery* query = nullptr;
+        std::vector<Predicate> predicates;  ///< Most selective first
+        size_t estimate = 0;
+        bool empty = false;                 ///< Some predicate matches nothing
+        QString foldedText;
+        RoaringBitmap genreIds;
+        uint64_t genreMask = 0;             ///< Column-store bits of query.genres, 0 = use genreIds
+        qint32 ratingLo = 0, ratingHi = 0;
+    };
+
+    const BookManager& m_manager;
+
+    Plan makePlan(const BookQuery& query) const
+    {
+        Plan plan;
+        plan.query = &query;
+        size_t total = m_manager.books().size();
+
+        if (query.candidateIds) {
+            plan.predicates.push_back(Predicate{Kind::Candidates, query.candidateIds->size()});
+        }
+        if (!query.genres.isEmpty()) {
+            plan.genreIds = m_manager.getGenresBitmap(query.genres, query.matchAllGenres);
+            plan.predicates.push_back(Predicate{Kind::Genre, plan.genreIds.cardinality()});
+            // Mask test only when every requested genre has its own bit
+            for (const QString& genre : query.genres) {
+                uint64_t bit = m_manager.getBookStore().genreBit(genre);
+                if (bit == 0) {
+                    plan.genreMask = 0;
+                    break;
+                }
+                plan.genreMask |= bit;
+            }
+        }
+        if (query.minYear != std::numeric_limits<int>::min() || query.maxYear != std::numeric_limits<int>::max()) {
+            plan.predicates.push_back(Predicate{Kind::Year, m_manager.getYearIndex().count(query.minYear, query.maxYear)});
+        }
+        plan.ratingLo = BookManager::ratingKey(query.minRating);
+        plan.ratingHi = BookManager::ratingKey(query.maxRating);
+        if (plan.ratingLo != std::numeric_limits<qint32>::min() || plan.ratingHi != std::numeric_limits<qint32>::max()) {
+            plan.predicates.push_back(Predicate{Kind::Rating, m_manager.getRatingIndex().count(plan.ratingLo, plan.ratingHi)});
+        }
+        if (!query.text.isEmpty()) {
+            plan.foldedText = query.text.toLower();
+            plan.predicates.push_back(Predicate{Kind::Text, m_manager.estimateIdsContaining(query.text, query.textInAuthor)});
+        }
+
+        // Stable: on equal estimates the cheaper checks (listed first) go first
+        std::stable_sort(plan.predicates.begin(), plan.predicates.end(),
+                         [](const Predicate& a, const Predicate& b) { return a.estimate < b.estimate; });
+
+        plan.estimate = plan.predicates.empty() ? total : plan.predicates.front().estimate;
+        plan.empty = plan.estimate == 0;
+        return plan;
+    }
+
+    /// Whether the book at a slot passes the predicates from index `from` on
+    bool matches(const Plan& plan, size_t from, uint32_t slot) const
+    {
+        const BookQuery& query = *plan.query;
+        const BookStore& store = m_manager.getBookStore();
+        int id = store.id(slot);
+        for (size_t p = from; p < plan.predicates.size(); p++) {
+            switch (plan.predicates[p].kind) {
+                case Kind::Candidates:
+                    if (!std::binary_search(query.candidateIds->begin(), query.candidateIds->end(), id)) return false;
+                    break;
+                case Kind::Genre:
+                    if (plan.genreMask != 0) {
+                        uint64_t hit = store.genreMasks()[slot] & plan.genreMask;
+                        if (query.matchAllGenres ? hit != plan.genreMask : hit == 0) return false;
+                    } else if (!plan.genreIds.contains(static_cast<uint32_t>(id))) {
+                        return false;
+                    }
+                    break;
+                case Kind::Year:
+                    if (store.year(slot) < query.minYear || store.year(slot) > query.maxYear) return false;
+                    break;
+                case Kind::Rating: {
+                    qint32 key = store.ratingKey(slot);
+                    if (key < plan.ratingLo || key > plan.ratingHi) return false;
+                    break;
+                }
+                case Kind::Text:
+                    if (!m_manager.matchesText(id, plan.foldedText, query.textInAuthor)) return false;
+                    break;
+            }
+        }
+        return true;
+    }
+
+    /// Collect the slots produced by the most selective predicate that pass the rest
+    void enumerateDriver(const Plan& plan, std::vector<uint32_t>& slots) const
+    {
+        const BookQuery& query = *plan.query;
+        slots.reserve(plan.predicates.front().estimate);
+        auto consider = [&](int id) {
+            uint32_t slot = m_manager.getSlotById(id);
+            if (slot == BookManager::kNoSlot) return;
+            if (matches(plan, 1, slot)) slots.push_back(slot);
+        };
+
+        switch (plan.predicates.front().kind) {
+            case Kind::Candidates:
+                for (int id : *query.candidateIds) consider(id);
+                break;
+            case Kind::Genre:
+                plan.genreIds.forEach([&](uint32_t id) { consider(static_cast<int>(id)); });
+                break;
+            case Kind::Year:
+                for (const RangeIndex::Entry& entry : m_manager.getYearIndex().range(query.minYear, query.maxYear)) {
+                    consider(entry.id);
+                }
+                break;
+            case Kind::Rating:
+                for (const RangeIndex::Entry& entry : m_manager.getRatingIndex().range(plan.ratingLo, plan.ratingHi)) {
+                    consider(entry.id);
+                }
+                break;
+            case Kind::Text:
+                for (int id : m_manager.findIdsContaining(query.text, query.textInAuthor)) consider(id);
+                break;
+        }
+    }
+
+    static constexpr size_t kCancelInterval = 4096;  ///< Books walked between two cancel checks
+
+    /// Walk books in output order, checking every predicate, until limit hits (no limit = all)
+    void walkInOutputOrder(const BookQuery& query, const Plan& plan, std::vector<uint32_t>& slots,
+                           const CancelCheck& cancelled) const
+    {
+        size_t total = m_manager.books().size();
+        size_t limit = query.limit > 0 ? query.limit : total;
+        size_t steps = 0;
+        auto keepGoing = [&]() {
+            if (slots.size() >= limit) return false;
+            return ++steps % kCancelInterval != 0 || !cancelled || !cancelled();
+        };
+        slots.reserve(std::min(limit, plan.estimate));
+        if (!query.ordered) {
+            for (uint32_t slot = 0; slot < total && keepGoing(); slot++) {
+                if (matches(plan, 0, slot)) slots.push_back(slot);
+            }
+            return;
+        }
+        m_manager.getSecondaryIndex(query.orderBy).forEachId(query.ascending, [&](int id) {
+            uint32_t slot = m_manager.getSlotById(id);
+            if (slot != BookManager::kNoSlot && matches(plan, 0, slot)) slots.push_back(slot);
+            return keepGoing();
+        });
+    }
+};
+
+#endif // QUERYENGINE_H
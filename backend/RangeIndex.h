@@ -0,0 +1,338 @@
+#ifndef RANGEINDEX_H
+#define RANGEINDEX_H
+
+#include "Sorting.h"
+#include <QtGlobal>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief Sorted sequence of (integer key, book ID) pairs for range queries
+ *
+ * Entries ordered by key then ID are kept in blocks of at most
+ * 2 x kBlockSize contiguous entries, and a Fenwick tree over the block
+ * sizes gives the position of any block in O(log n). Range bounds are a
+ * binary search over the block tails plus one inside a block, so counting
+ * the books in [lo, hi] is O(log n) and the matching entries come back as
+ * a view (iterator pair) without copying. A single insert or erase shifts
+ * at most one block (O(log n + kBlockSize)) instead of the whole tail of a
+ * flat array; splitting a full block or dropping an emptied one rebuilds
+ * the directory, which happens at most once per kBlockSize/4 updates.
+ */
+class RangeIndex
+{
+public:
+    static constexpr size_t kBlockSize = 512;  ///< Target block length (blocks hold kBlockSize/4 .. 2 x kBlockSize)
+
+    struct Entry {
+        qint32 key;
+        int id;
+
+        bool operator<(const Entry& other) const
+        {
+            return key != other.key ? key < other.key : id < other.id;
+        }
+    };
+
+    /**
+     * @brief Bidirectional iterator in (key, id) order
+     * Distance and offset (it - other, it + n) cost O(log n).
+     */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entry*;
+        using reference = const Entry&;
+
+        const_iterator() : m_index(nullptr), m_block(0), m_offset(0) {}
+
+        reference operator*() const { return m_index->m_blocks[m_block][m_offset]; }
+        pointer operator->() const { return &**this; }
+
+        const_iterator& operator++()
+        {
+            if (++m_offset == m_index->m_blocks[m_block].size()) {
+                m_block++;
+                m_offset = 0;
+            }
+            return *this;
+        }
+
+        const_iterator& operator--()
+        {
+            if (m_offset == 0) {
+                m_block--;
+                m_offset = m_index->m_blocks[m_block].size();
+            }
+            m_offset--;
+            return *this;
+        }
+
+        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+        const_iterator operator--(int) { const_iterator old = *this; --*this; return old; }
+
+        /**
+         * @brief Number of entries before this one - O(log n)
+         */
+        size_t position() const { return m_index->blockStart(m_block) + m_offset; }
+
+        const_iterator operator+(difference_type n) const
+        {
+            return m_index->iteratorAt(static_cast<size_t>(static_cast<difference_type>(position()) + n));
+        }
+
+        difference_type operator-(const const_iterator& other) const
+        {
+            return static_cast<difference_type>(position()) - static_cast<difference_type>(other.position());
+        }
+
+        bool operator==(const const_iterator& other) const { return m_block == other.m_block && m_offset == other.m_offset; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class RangeIndex;
+        const_iterator(const RangeIndex* index, size_t block, size_t offset)
+            : m_index(index), m_block(block), m_offset(offset) {}
+
+        const RangeIndex* m_index;
+        size_t m_block;   ///< Block number, m_blocks.size() for end()
+        size_t m_offset;  ///< Position inside the block (0 for end())
+    };
+
+    /**
+     * @brief Contiguous slice of the index (no copy)
+     */
+    struct View {
+        const_iterator first;
+        const_iterator last;
+
+        const_iterator begin() const { return first; }
+        const_iterator end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
+    RangeIndex() : m_size(0) {}
+
+    /**
+     * @brief Add one entry - O(log n + kBlockSize)
+     */
+    void insert(qint32 key, int id)
+    {
+        Entry entry{key, id};
+        if (m_blocks.empty()) {
+            m_blocks.emplace_back(1, entry);
+            m_size = 1;
+            rebuildTree();
+            return;
+        }
+        // Into the first block whose last entry is not smaller (or the last block)
+        size_t block = std::min(blockFor(entry), m_blocks.size() - 1);
+        std::vector<Entry>& entries = m_blocks[block];
+        entries.insert(std::lower_bound(entries.begin(), entries.end(), entry), entry);
+        m_size++;
+        if (entries.size() > 2 * kBlockSize) {
+            std::vector<Entry> upper(entries.begin() + kBlockSize, entries.end());
+            entries.resize(kBlockSize);
+            m_blocks.insert(m_blocks.begin() + static_cast<std::ptrdiff_t>(block) + 1, std::move(upper));
+            rebuildTree();
+        } else {
+            addToTree(block, 1);
+        }
+    }
+
+    /**
+     * @brief Remove one entry - O(log n + kBlockSize)
+     * @return true if the entry was present
+     */
+    bool erase(qint32 key, int id)
+    {
+        Entry entry{key, id};
+        size_t block = blockFor(entry);
+        if (block == m_blocks.size()) return false;
+        std::vector<Entry>& entries = m_blocks[block];
+        auto it = std::lower_bound(entries.begin(), entries.end(), entry);
+        if (it == entries.end() || it->key != key || it->id != id) return false;
+        entries.erase(it);
+        m_size--;
+        if (entries.size() < kBlockSize / 4 && (entries.empty() || m_blocks.size() > 1)) {
+            mergeSmallBlock(block);
+        } else {
+            addToTree(block, -1);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Replace the whole index (sorted once with our own QuickSort)
+     * @param entries One entry per book (consumed)
+     */
+    void assign(std::vector<Entry> entries)
+    {
+        Sorting::quickSort(entries);
+        m_blocks.clear();
+        m_blocks.reserve((entries.size() + kBlockSize - 1) / kBlockSize);
+        for (size_t i = 0; i < entries.size(); i += kBlockSize) {
+            size_t end = std::min(i + kBlockSize, entries.size());
+            m_blocks.emplace_back(entries.begin() + static_cast<std::ptrdiff_t>(i),
+                                  entries.begin() + static_cast<std::ptrdiff_t>(end));
+        }
+        m_size = entries.size();
+        rebuildTree();
+    }
+
+    void clear()
+    {
+        m_blocks.clear();
+        m_tree.clear();
+        m_size = 0;
+    }
+
+    /**
+     * @brief First entry with key >= value - O(log n)
+     */
+    const_iterator lowerBound(qint32 value) const
+    {
+        auto block = std::partition_point(m_blocks.begin(), m_blocks.end(),
+                                          [value](const std::vector<Entry>& b) { return b.back().key < value; });
+        if (block == m_blocks.end()) return end();
+        auto it = std::lower_bound(block->begin(), block->end(), value,
+                                   [](const Entry& e, qint32 v) { return e.key < v; });
+        return const_iterator(this, static_cast<size_t>(block - m_blocks.begin()), static_cast<size_t>(it - block->begin()));
+    }
+
+    /**
+     * @brief First entry with key > value - O(log n)
+     */
+    const_iterator upperBound(qint32 value) const
+    {
+        auto block = std::partition_point(m_blocks.begin(), m_blocks.end(),
+                                          [value](const std::vector<Entry>& b) { return !(value < b.back().key); });
+        if (block == m_blocks.end()) return end();
+        auto it = std::upper_bound(block->begin(), block->end(), value,
+                                   [](qint32 v, const Entry& e) { return v < e.key; });
+        return const_iterator(this, static_cast<size_t>(block - m_blocks.begin()), static_cast<size_t>(it - block->begin()));
+    }
+
+    /**
+     * @brief Entries with lo <= key <= hi, in key order - O(log n)
+     */
+    View range(qint32 lo, qint32 hi) const
+    {
+        if (lo > hi) return View{end(), end()};
+        return View{lowerBound(lo), upperBound(hi)};
+    }
+
+    /**
+     * @brief Number of entries with lo <= key <= hi - O(log n)
+     */
+    size_t count(qint32 lo, qint32 hi) const { return range(lo, hi).size(); }
+
+    /**
+     * @brief Number of entries with key < value (rank of value) - O(log n)
+     * The block-size tree turns the lower bound into a position.
+     */
+    size_t rank(qint32 value) const { return lowerBound(value).position(); }
+
+    /**
+     * @brief Number of entries with key >= value - O(log n)
+     */
+    size_t countAtLeast(qint32 value) const { return m_size - rank(value); }
+
+    /**
+     * @brief Entry at a position in (key, id) order - O(log n)
+     * @param index Position, must be < size()
+     */
+    const Entry& select(size_t index) const { return *iteratorAt(index); }
+
+    const_iterator begin() const { return m_blocks.empty() ? end() : const_iterator(this, 0, 0); }
+    const_iterator end() const { return const_iterator(this, m_blocks.size(), 0); }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+private:
+    std::vector<std::vector<Entry>> m_blocks;  ///< Non-empty sorted blocks; their concatenation is sorted
+    std::vector<size_t> m_tree;                ///< Fenwick tree over block sizes (1-based)
+    size_t m_size;
+
+    /// First block whose last entry is >= entry, m_blocks.size() if none
+    size_t blockFor(const Entry& entry) const
+    {
+        auto block = std::partition_point(m_blocks.begin(), m_blocks.end(),
+                                          [&entry](const std::vector<Entry>& b) { return b.back() < entry; });
+        return static_cast<size_t>(block - m_blocks.begin());
+    }
+
+    /// Number of entries in the blocks before `block`
+    size_t blockStart(size_t block) const
+    {
+        size_t sum = 0;
+        for (size_t i = block; i > 0; i -= i & (~i + 1)) sum += m_tree[i];
+        return sum;
+    }
+
+    /// Iterator to the entry at a position (end() if past the last entry)
+    const_iterator iteratorAt(size_t position) const
+    {
+        if (position >= m_size) return end();
+        // Fenwick descent: largest block count whose total stays <= position
+        size_t block = 0;
+        size_t step = 1;
+        while (step * 2 <= m_blocks.size()) step *= 2;
+        for (; step > 0; step /= 2) {
+            if (block + step <= m_blocks.size() && m_tree[block + step] <= position) {
+                block += step;
+                position -= m_tree[block];
+            }
+        }
+        return const_iterator(this, block, position);
+    }
+
+    void addToTree(size_t block, std::ptrdiff_t delta)
+    {
+        for (size_t i = block + 1; i < m_tree.size(); i += i & (~i + 1)) {
+            m_tree[i] = static_cast<size_t>(static_cast<std::ptrdiff_t>(m_tree[i]) + delta);
+        }
+    }
+
+    /// O(blocks) linear-time Fenwick build, after blocks were split, merged or removed
+    void rebuildTree()
+    {
+        m_tree.assign(m_blocks.size() + 1, 0);
+        for (size_t i = 1; i < m_tree.size(); i++) {
+            m_tree[i] += m_blocks[i - 1].size();
+            size_t parent = i + (i & (~i + 1));
+            if (parent < m_tree.size()) m_tree[parent] += m_tree[i];
+        }
+    }
+
+    /// Fold an underfull block into a neighbour (re-splitting if that overflows)
+    void mergeSmallBlock(size_t block)
+    {
+        if (m_blocks[block].empty() || m_blocks.size() == 1) {
+            if (m_blocks[block].empty()) m_blocks.erase(m_blocks.begin() + static_cast<std::ptrdiff_t>(block));
+            rebuildTree();
+            return;
+        }
+        size_t left = block + 1 < m_blocks.size() ? block : block - 1;
+        std::vector<Entry>& low = m_blocks[left];
+        std::vector<Entry>& high = m_blocks[left + 1];
+        low.insert(low.end(), high.begin(), high.end());
+        if (low.size() > 2 * kBlockSize) {
+            size_t half = low.size() / 2;
+            high.assign(low.begin() + static_cast<std::ptrdiff_t>(half), low.end());
+            low.resize(half);
+        } else {
+            m_blocks.erase(m_blocks.begin() + static_cast<std::ptrdiff_t>(left) + 1);
+        }
+        rebuildTree();
+    }
+};
+
+#endif // RANGEINDEX_H
@@ -0,0 +1,303 @@
+#ifndef ROARINGBITMAP_H
+#define ROARINGBITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Compressed bitmap of 32-bit values (roaring-style)
+ *
+ * Values are split into 2^16 chunks by their high 16 bits. Each chunk is
+ * stored either as a sorted array of low 16-bit halves (up to 4096
+ * values, 2 bytes each) or as a 65536-bit bitset (8 KB), whichever is
+ * smaller, so both sparse and dense sets stay compact. Intersections and
+ * unions work chunk by chunk: array/array by merging, bitset/bitset word
+ * by word with hardware popcount for the new cardinality.
+ */
+class RoaringBitmap
+{
+public:
+    /**
+     * @brief Add a value - O(log chunks + chunk size)
+     * @return true if the value was not present
+     */
+    bool add(uint32_t value)
+    {
+        uint16_t key = static_cast<uint16_t>(value >> 16);
+        uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+        auto it = std::lower_bound(m_chunks.begin(), m_chunks.end(), key,
+                                   [](const Chunk& c, uint16_t k) { return c.key < k; });
+        if (it == m_chunks.end() || it->key != key) {
+            it = m_chunks.insert(it, Chunk(key));
+        }
+        Chunk& chunk = *it;
+
+        if (chunk.isBitset()) {
+            uint64_t bit = uint64_t(1) << (low & 63);
+            uint64_t& word = chunk.bits[low >> 6];
+            if (word & bit) return false;
+            word |= bit;
+            chunk.cardinality++;
+            return true;
+        }
+
+        auto pos = std::lower_bound(chunk.values.begin(), chunk.values.end(), low);
+        if (pos != chunk.values.end() && *pos == low) return false;
+        chunk.values.insert(pos, low);
+        chunk.cardinality++;
+        if (chunk.cardinality > kArrayLimit) chunk.toBitset();
+        return true;
+    }
+
+    /**
+     * @brief Remove a value
+     * @return true if the value was present
+     */
+    bool remove(uint32_t value)
+    {
+        uint16_t key = static_cast<uint16_t>(value >> 16);
+        uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+        auto it = findChunk(key);
+        if (it == m_chunks.end()) return false;
+        Chunk& chunk = *it;
+
+        if (chunk.isBitset()) {
+            uint64_t bit = uint64_t(1) << (low & 63);
+            uint64_t& word = chunk.bits[low >> 6];
+            if (!(word & bit)) return false;
+            word &= ~bit;
+            chunk.cardinality--;
+            if (chunk.cardinality <= kArrayLimit) chunk.toArray();
+        } else {
+            auto pos = std::lower_bound(chunk.values.begin(), chunk.values.end(), low);
+            if (pos == chunk.values.end() || *pos != low) return false;
+            chunk.values.erase(pos);
+            chunk.cardinality--;
+        }
+        if (chunk.cardinality == 0) m_chunks.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief Check membership - O(log chunks) + O(1) or O(log 4096)
+     */
+    bool contains(uint32_t value) const
+    {
+        auto it = findChunk(static_cast<uint16_t>(value >> 16));
+        if (it == m_chunks.end()) return false;
+        uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+        if (it->isBitset()) return (it->bits[low >> 6] >> (low & 63)) & 1;
+        return std::binary_search(it->values.begin(), it->values.end(), low);
+    }
+
+    /**
+     * @brief Number of values stored - O(chunks)
+     */
+    size_t cardinality() const
+    {
+        size_t total = 0;
+        for (const Chunk& chunk : m_chunks) total += chunk.cardinality;
+        return total;
+    }
+
+    bool empty() const { return m_chunks.empty(); }
+    void clear() { m_chunks.clear(); }
+
+    /**
+     * @brief Values present in both bitmaps (AND)
+     */
+    static RoaringBitmap intersect(const RoaringBitmap& a, const RoaringBitmap& b)
+    {
+        RoaringBitmap result;
+        size_t i = 0, j = 0;
+        while (i < a.m_chunks.size() && j < b.m_chunks.size()) {
+            const Chunk& x = a.m_chunks[i];
+            const Chunk& y = b.m_chunks[j];
+            if (x.key < y.key) { i++; continue; }
+            if (y.key < x.key) { j++; continue; }
+            Chunk chunk = intersectChunks(x, y);
+            if (chunk.cardinality > 0) result.m_chunks.push_back(std::move(chunk));
+            i++;
+            j++;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Values present in either bitmap (OR)
+     */
+    static RoaringBitmap unite(const RoaringBitmap& a, const RoaringBitmap& b)
+    {
+        RoaringBitmap result;
+        size_t i = 0, j = 0;
+        while (i < a.m_chunks.size() || j < b.m_chunks.size()) {
+            if (j == b.m_chunks.size() || (i < a.m_chunks.size() && a.m_chunks[i].key < b.m_chunks[j].key)) {
+                result.m_chunks.push_back(a.m_chunks[i++]);
+            } else if (i == a.m_chunks.size() || b.m_chunks[j].key < a.m_chunks[i].key) {
+                result.m_chunks.push_back(b.m_chunks[j++]);
+            } else {
+                result.m_chunks.push_back(uniteChunks(a.m_chunks[i++], b.m_chunks[j++]));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Visit every value in ascending order
+     * @param visit Callback taking the uint32_t value
+     */
+    template<typename Visitor>
+    void forEach(Visitor visit) const
+    {
+        for (const Chunk& chunk : m_chunks) {
+            uint32_t high = static_cast<uint32_t>(chunk.key) << 16;
+            if (!chunk.isBitset()) {
+                for (uint16_t low : chunk.values) visit(high | low);
+                continue;
+            }
+            for (uint32_t w = 0; w < kBitsetWords; w++) {
+                // Peel set bits off one word at a time (lowest first)
+                for (uint64_t word = chunk.bits[w]; word != 0; word &= word - 1) {
+                    visit(high | (w << 6) | countTrailingZeros(word));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief All values in ascending order
+     */
+    std::vector<uint32_t> toVector() const
+    {
+        std::vector<uint32_t> out;
+        out.reserve(cardinality());
+        forEach([&out](uint32_t value) { out.push_back(value); });
+        return out;
+    }
+
+private:
+    static constexpr uint32_t kArrayLimit = 4096;    ///< Larger chunks switch to a bitset
+    static constexpr uint32_t kBitsetWords = 1024;   ///< 65536 bits
+
+    struct Chunk {
+        uint16_t key;
+        uint32_t cardinality;
+        std::vector<uint16_t> values;  ///< Sorted low halves (array chunk)
+        std::vector<uint64_t> bits;    ///< 1024 words (bitset chunk), empty for array chunks
+
+        explicit Chunk(uint16_t k) : key(k), cardinality(0) {}
+
+        bool isBitset() const { return !bits.empty(); }
+
+        void toBitset()
+        {
+            bits.assign(kBitsetWords, 0);
+            for (uint16_t low : values) bits[low >> 6] |= uint64_t(1) << (low & 63);
+            values = std::vector<uint16_t>();
+        }
+
+        void toArray()
+        {
+            values.clear();
+            values.reserve(cardinality);
+            for (uint32_t w = 0; w < kBitsetWords; w++) {
+                for (uint64_t word = bits[w]; word != 0; word &= word - 1) {
+                    values.push_back(static_cast<uint16_t>((w << 6) | countTrailingZeros(word)));
+                }
+            }
+            bits = std::vector<uint64_t>();
+        }
+    };
+
+    std::vector<Chunk> m_chunks;  ///< Non-empty chunks sorted by key
+
+    std::vector<Chunk>::const_iterator findChunk(uint16_t key) const
+    {
+        auto it = std::lower_bound(m_chunks.begin(), m_chunks.end(), key,
+                                   [](const Chunk& c, uint16_t k) { return c.key < k; });
+        return (it != m_chunks.end() && it->key == key) ? it : m_chunks.end();
+    }
+
+    std::vector<Chunk>::iterator findChunk(uint16_t key)
+    {
+        auto it = std::lower_bound(m_chunks.begin(), m_chunks.end(), key,
+                                   [](const Chunk& c, uint16_t k) { return c.key < k; });
+        return (it != m_chunks.end() && it->key == key) ? it : m_chunks.end();
+    }
+
+    static uint32_t popcount(uint64_t word)
+    {
+#if defined(_MSC_VER)
+        return static_cast<uint32_t>(__popcnt64(word));
+#else
+        return static_cast<uint32_t>(__builtin_popcountll(word));
+#endif
+    }
+
+    static uint32_t countTrailingZeros(uint64_t word)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<uint32_t>(index);
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(word));
+#endif
+    }
+
+    static Chunk intersectChunks(const Chunk& x, const Chunk& y)
+    {
+        Chunk out(x.key);
+        if (x.isBitset() && y.isBitset()) {
+            out.bits.resize(kBitsetWords);
+            for (uint32_t w = 0; w < kBitsetWords; w++) {
+                out.bits[w] = x.bits[w] & y.bits[w];
+                out.cardinality += popcount(out.bits[w]);
+            }
+            if (out.cardinality <= kArrayLimit) out.toArray();
+            return out;
+        }
+        if (x.isBitset() || y.isBitset()) {
+            // Array side is at most 4096 values: probe each one in the bitset
+            const Chunk& array = x.isBitset() ? y : x;
+            const Chunk& bitset = x.isBitset() ? x : y;
+            for (uint16_t low : array.values) {
+                if ((bitset.bits[low >> 6] >> (low & 63)) & 1) out.values.push_back(low);
+            }
+        } else {
+            std::set_intersection(x.values.begin(), x.values.end(), y.values.begin(), y.values.end(),
+                                  std::back_inserter(out.values));
+        }
+        out.cardinality = static_cast<uint32_t>(out.values.size());
+        return out;
+    }
+
+    static Chunk uniteChunks(const Chunk& x, const Chunk& y)
+    {
+        Chunk out(x.key);
+        if (!x.isBitset() && !y.isBitset()) {
+            std::set_union(x.values.begin(), x.values.end(), y.values.begin(), y.values.end(),
+                           std::back_inserter(out.values));
+            out.cardinality = static_cast<uint32_t>(out.values.size());
+            if (out.cardinality > kArrayLimit) out.toBitset();
+            return out;
+        }
+        out.bits.assign(kBitsetWords, 0);
+        for (const Chunk* side : {&x, &y}) {
+            if (side->isBitset()) {
+                for (uint32_t w = 0; w < kBitsetWords; w++) out.bits[w] |= side->bits[w];
+            } else {
+                for (uint16_t low : side->values) out.bits[low >> 6] |= uint64_t(1) << (low & 63);
+            }
+        }
+        for (uint64_t word : out.bits) out.cardinality += popcount(word);
+        return out;
+    }
+};
+
+#endif // ROARINGBITMAP_H
@@ -0,0 +1,114 @@
+#ifndef SEARCHSESSION_H
+#define SEARCHSESSION_H
+
+#include "BookManager.h"
+#include <QString>
+#include <vector>
+
+/**
+ * @brief Type-ahead search state that narrows the previous hits instead of starting over
+ *
+ * Every substring match of a query that contains the previous query is
+ * also a match of the previous query, so when the user types one more
+ * character the session only re-checks the IDs it already found. Earlier
+ * steps are kept on a small stack, so deleting characters (backspace)
+ * returns the cached hits of the shorter query without searching again.
+ * Any other edit, or any change of the catalog version, falls back to a
+ * full index lookup.
+ *
+ * A session created without a manager takes one per find() call, e.g. the
+ * BookManager::getReadView() a worker thread searches. Views of the same
+ * version hold the same books, so the cached steps carry over between them.
+ * The session itself is not thread-safe: one find() at a time.
+ */
+class SearchSession
+{
+public:
+    /**
+     * @brief Create a session over a book manager
+     * @param manager Manager whose indexes answer the queries (must outlive the session)
+     * @param includeAuthor Also match against the author, not only the title
+     */
+    explicit SearchSession(const BookManager& manager, bool includeAuthor = true)
+        : m_manager(&manager), m_includeAuthor(includeAuthor), m_version(0), m_lastRefined(false) {}
+
+    /**
+     * @brief Create a session that is given the manager on every find()
+     * @param includeAuthor Also match against the author, not only the title
+     */
+    explicit SearchSession(bool includeAuthor = true)
+        : m_manager(nullptr), m_includeAuthor(includeAuthor), m_version(0), m_lastRefined(false) {}
+
+    /**
+     * @brief Find books whose title (and author) contain a query
+     * Only for sessions created with a manager.
+     * @param query Query text (case-insensitive)
+     * @return Matching book IDs in ascending order (valid until the next call)
+     */
+    const std::vector<int>& find(const QString& query) { return find(*m_manager, query); }
+
+    /**
+     * @brief Find books whose title (and author) contain a query, using a given manager
+     * @param manager Manager (or read view) whose indexes answer the query
+     * @param query Query text (case-insensitive)
+     * @return Matching book IDs in ascending order (valid until the next call)
+     */
+    const std::vector<int>& find(const BookManager& manager, const QString& query)
+    {
+        QString folded = query.toLower();
+        if (manager.getVersion() != m_version) {
+            reset();
+            m_version = manager.getVersion();
+        }
+
+        // Drop steps the new query does not extend (e.g. after backspace or paste)
+        while (!m_steps.empty() && !folded.contains(m_steps.back().query)) {
+            m_steps.pop_back();
+        }
+
+        if (!m_steps.empty() && m_steps.back().query == folded) {
+            m_lastRefined = true;
+            return m_steps.back().ids;
+        }
+
+        Step step;
+        step.query = folded;
+        if (m_steps.empty()) {
+            step.ids = manager.findIdsContaining(folded, m_includeAuthor);
+            m_lastRefined = false;
+        } else {
+            step.ids = manager.refineIdsContaining(m_steps.back().ids, folded, m_includeAuthor);
+            m_lastRefined = true;
+        }
+        m_steps.push_back(std::move(step));
+        return m_steps.back().ids;
+    }
+
+    /**
+     * @brief Forget all cached steps
+     */
+    void reset()
+    {
+        m_steps.clear();
+        m_lastRefined = false;
+    }
+
+    /**
+     * @brief Whether the last find() reused cached hits instead of a full lookup
+     */
+    bool lastWasRefined() const { return m_lastRefined; }
+
+private:
+    struct Step {
+        QString query;         ///< Folded query
+        std::vector<int> ids;  ///< Its matching IDs, ascending
+    };
+
+    const BookManager* m_manager; ///< Bound manager, nullptr = passed to find()
+    bool m_includeAuthor;
+    quint64 m_version;         ///< Catalog version the cached steps belong to
+    bool m_lastRefined;
+    std::vector<Step> m_steps; ///< Each step's query contains the previous one
+};
+
+#endif // SEARCHSESSION_H
@@ -5,6 +5,9 @@
 #include <functional>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
 
 /**
  * @brief Collection of searching algorithms
@@ -74,6 +77,138 @@ namespace Searching
         return -1;
     }
 
+    /**
+     * @brief Default three-way comparison for keys with operator<
+     * @return Negative if a < b, zero if equal, positive if a > b
+     */
+    struct ThreeWay {
+        template<typename A, typename B>
+        int operator()(const A& a, const B& b) const { return a < b ? -1 : (b < a ? 1 : 0); }
+    };
+
+    /**
+     * @brief First position whose element is not ordered before key
+     *
+     * The comparator is a template parameter, so it is inlined instead of
+     * going through std::function, and it compares an element with the key
+     * in place (heterogeneous lookup): no key is extracted or copied per
+     * probe. One three-way callable serves lowerBound, upperBound and
+     * equalRange alike.
+     *
+     * @tparam RandomIt Random access iterator
+     * @tparam Key Key type (may differ from the element type)
+     * @tparam Compare3 int(const Element&, const Key&): <0, 0 or >0
+     * @return Iterator to the first element with compare(element, key) >= 0
+     */
+    template<typename RandomIt, typename Key, typename Compare3>
+    RandomIt lowerBound(RandomIt first, RandomIt last, const Key& key, Compare3 compare)
+    {
+        auto count = last - first;
+        while (count > 0) {
+            auto half = count / 2;
+            RandomIt mid = first + half;
+            if (compare(*mid, key) < 0) {
+                first = mid + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first;
+    }
+
+    template<typename RandomIt, typename Key>
+    RandomIt lowerBound(RandomIt first, RandomIt last, const Key& key)
+    {
+        return lowerBound(first, last, key, ThreeWay());
+    }
+
+    /**
+     * @brief First position whose element is ordered after key
+     * @return Iterator to the first element with compare(element, key) > 0
+     */
+    template<typename RandomIt, typename Key, typename Compare3>
+    RandomIt upperBound(RandomIt first, RandomIt last, const Key& key, Compare3 compare)
+    {
+        auto count = last - first;
+        while (count > 0) {
+            auto half = count / 2;
+            RandomIt mid = first + half;
+            if (compare(*mid, key) <= 0) {
+                first = mid + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first;
+    }
+
+    template<typename RandomIt, typename Key>
+    RandomIt upperBound(RandomIt first, RandomIt last, const Key& key)
+    {
+        return upperBound(first, last, key, ThreeWay());
+    }
+
+    /**
+     * @brief Range of elements equal to key: [lowerBound, upperBound)
+     */
+    template<typename RandomIt, typename Key, typename Compare3>
+    std::pair<RandomIt, RandomIt> equalRange(RandomIt first, RandomIt last, const Key& key, Compare3 compare)
+    {
+        RandomIt lower = lowerBound(first, last, key, compare);
+        return std::make_pair(lower, upperBound(lower, last, key, compare));
+    }
+
+    template<typename RandomIt, typename Key>
+    std::pair<RandomIt, RandomIt> equalRange(RandomIt first, RandomIt last, const Key& key)
+    {
+        return equalRange(first, last, key, ThreeWay());
+    }
+
+    /**
+     * @brief Branchless lower bound for cheap comparisons (integers, packed keys)
+     *
+     * The loop runs exactly ceil(log2 n) times and the only data-dependent
+     * choice is a conditional move, so there are no branch mispredictions.
+     * Same result as lowerBound(); prefer lowerBound() when a comparison is
+     * expensive (e.g. strings), since this variant never stops early.
+     */
+    template<typename RandomIt, typename Key, typename Compare3>
+    RandomIt branchlessLowerBound(RandomIt first, RandomIt last, const Key& key, Compare3 compare)
+    {
+        auto count = last - first;
+        if (count == 0) return first;
+        while (count > 1) {
+            auto half = count / 2;
+            first = compare(first[half - 1], key) < 0 ? first + half : first;
+            count -= half;
+        }
+        return first + (compare(*first, key) < 0 ? 1 : 0);
+    }
+
+    template<typename RandomIt, typename Key>
+    RandomIt branchlessLowerBound(RandomIt first, RandomIt last, const Key& key)
+    {
+        return branchlessLowerBound(first, last, key, ThreeWay());
+    }
+
+    /**
+     * @brief Binary Search with a heterogeneous three-way comparator
+     * Replacement for binarySearchByKey() without std::function or key copies.
+     * @param arr Vector sorted consistently with compare
+     * @param key Key to search for
+     * @param compare int(const T&, const Key&): <0, 0 or >0
+     * @return Index of the first matching element, -1 if not found
+     */
+    template<typename T, typename Key, typename Compare3>
+    int binarySearchBy(const std::vector<T>& arr, const Key& key, Compare3 compare)
+    {
+        auto it = lowerBound(arr.begin(), arr.end(), key, compare);
+        if (it == arr.end() || compare(*it, key) != 0) return -1;
+        return static_cast<int>(it - arr.begin());
+    }
+
     /**
      * @brief Linear Search algorithm
      * @tparam T Type of elements
@@ -131,6 +266,130 @@ namespace Searching
         return results;
     }
 
+    /**
+     * @brief Bounded Levenshtein (edit) distance from one pattern to many texts
+     *
+     * Patterns of up to 64 characters use Myers' bit-parallel algorithm:
+     * the whole DP column is held in two 64-bit vectors, so each text
+     * character costs a handful of word operations. Longer patterns fall
+     * back to the classic two-row DP. Both stop early once the distance
+     * can no longer come back under the bound.
+     *
+     * @tparam CharT Character type (e.g. ushort for QString::utf16())
+     */
+    template<typename CharT>
+    class EditDistanceMatcher
+    {
+    public:
+        /**
+         * @brief Prepare a pattern (the per-character match masks are built once)
+         * @param pattern Pattern characters
+         * @param length Number of characters
+         */
+        EditDistanceMatcher(const CharT* pattern, size_t length)
+            : m_pattern(pattern, pattern + length)
+        {
+            for (uint64_t& mask : m_lowMasks) mask = 0;
+            if (length > 64) return;
+            for (size_t i = 0; i < length; i++) {
+                uint64_t bit = uint64_t(1) << i;
+                uint32_t c = static_cast<uint32_t>(pattern[i]);
+                if (c < kLowRange) {
+                    m_lowMasks[c] |= bit;
+                    continue;
+                }
+                auto it = std::lower_bound(m_highChars.begin(), m_highChars.end(), c);
+                size_t slot = it - m_highChars.begin();
+                if (it == m_highChars.end() || *it != c) {
+                    m_highChars.insert(it, c);
+                    m_highMasks.insert(m_highMasks.begin() + slot, 0);
+                }
+                m_highMasks[slot] |= bit;
+            }
+        }
+
+        /**
+         * @brief Edit distance between the pattern and a text
+         * @param text Text characters
+         * @param n Number of characters
+         * @param maxDistance Largest distance of interest
+         * @return Distance, or maxDistance + 1 if it is larger
+         */
+        int distance(const CharT* text, size_t n, int maxDistance) const
+        {
+            int m = static_cast<int>(m_pattern.size());
+            int tooFar = maxDistance + 1;
+            if (std::abs(static_cast<int>(n) - m) > maxDistance) return tooFar;
+            if (m == 0) return static_cast<int>(n);
+            int d = m <= 64 ? myers(text, n, maxDistance) : twoRow(text, n, maxDistance);
+            return d <= maxDistance ? d : tooFar;
+        }
+
+    private:
+        static constexpr uint32_t kLowRange = 256;  ///< Direct mask table for Latin-1
+
+        std::vector<CharT> m_pattern;
+        uint64_t m_lowMasks[kLowRange];
+        std::vector<uint32_t> m_highChars;   ///< Sorted pattern characters >= kLowRange
+        std::vector<uint64_t> m_highMasks;   ///< Match mask of each m_highChars entry
+
+        uint64_t maskOf(CharT ch) const
+        {
+            uint32_t c = static_cast<uint32_t>(ch);
+            if (c < kLowRange) return m_lowMasks[c];
+            auto it = std::lower_bound(m_highChars.begin(), m_highChars.end(), c);
+            return (it != m_highChars.end() && *it == c) ? m_highMasks[it - m_highChars.begin()] : 0;
+        }
+
+        int myers(const CharT* text, size_t n, int maxDistance) const
+        {
+            int m = static_cast<int>(m_pattern.size());
+            uint64_t last = uint64_t(1) << (m - 1);
+            uint64_t pv = ~uint64_t(0);
+            uint64_t mv = 0;
+            int score = m;
+
+            for (size_t j = 0; j < n; j++) {
+                uint64_t eq = maskOf(text[j]);
+                uint64_t xv = eq | mv;
+                uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+                uint64_t ph = mv | ~(xh | pv);
+                uint64_t mh = pv & xh;
+                if (ph & last) score++;
+                else if (mh & last) score--;
+
+                // Each remaining text character lowers the score by at most one
+                if (score - static_cast<int>(n - j - 1) > maxDistance) return maxDistance + 1;
+
+                ph = (ph << 1) | 1;  // Row 0 is D[0][j] = j (global alignment)
+                mh <<= 1;
+                pv = mh | ~(xv | ph);
+                mv = ph & xv;
+            }
+            return score;
+        }
+
+        int twoRow(const CharT* text, size_t n, int maxDistance) const
+        {
+            size_t m = m_pattern.size();
+            std::vector<int> prev(m + 1), cur(m + 1);
+            for (size_t i = 0; i <= m; i++) prev[i] = static_cast<int>(i);
+
+            for (size_t j = 1; j <= n; j++) {
+                cur[0] = static_cast<int>(j);
+                int rowMin = cur[0];
+                for (size_t i = 1; i <= m; i++) {
+                    int substitute = prev[i - 1] + (m_pattern[i - 1] == text[j - 1] ? 0 : 1);
+                    cur[i] = std::min(substitute, std::min(prev[i], cur[i - 1]) + 1);
+                    rowMin = std::min(rowMin, cur[i]);
+                }
+                if (rowMin > maxDistance) return maxDistance + 1;
+                prev.swap(cur);
+            }
+            return prev[m];
+        }
+    };
+
 } // namespace Searching
 
 #endif // SEARCHING_H
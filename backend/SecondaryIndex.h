@@ -0,0 +1,119 @@
+#ifndef SECONDARYINDEX_H
+#define SECONDARYINDEX_H
+
+#include "Sorting.h"
+#include <QString>
+#include <QtGlobal>
+#include <set>
+#include <vector>
+#include <utility>
+
+/**
+ * @brief Ordered secondary index over one book field
+ *
+ * Stores one (key, ID) entry per book in a balanced search tree, so the
+ * index stays sorted while books are added, removed or edited (O(log n)
+ * per change) and can be walked in either direction without sorting.
+ * Text fields use the case-folded text as key, numeric fields use an
+ * integer key; ties are broken by ascending book ID.
+ */
+class SecondaryIndex
+{
+public:
+    /**
+     * @brief Index entry (text key for title/author, numeric key for year/rating)
+     */
+    struct Entry {
+        QString text;
+        qint32 number;
+        int id;
+
+        Entry() : number(0), id(0) {}
+        Entry(const QString& t, qint32 n, int bookId) : text(t), number(n), id(bookId) {}
+    };
+
+    /**
+     * @brief Strict weak ordering on entries: text, then number, then ID
+     */
+    struct EntryLess {
+        bool operator()(const Entry& a, const Entry& b) const
+        {
+            int cmp = QString::compare(a.text, b.text);
+            if (cmp != 0) return cmp < 0;
+            if (a.number != b.number) return a.number < b.number;
+            return a.id < b.id;
+        }
+    };
+
+    using Container = std::set<Entry, EntryLess>;
+    using const_iterator = Container::const_iterator;
+    using const_reverse_iterator = Container::const_reverse_iterator;
+
+    /**
+     * @brief Insert entry for one book - O(log n)
+     */
+    void insert(const Entry& entry) { m_entries.insert(entry); }
+
+    /**
+     * @brief Remove entry for one book - O(log n)
+     * @return true if the entry was present
+     */
+    bool erase(const Entry& entry) { return m_entries.erase(entry) > 0; }
+
+    /**
+     * @brief Replace the whole index with the given entries
+     * Entries are sorted with our own QuickSort and appended in order, so
+     * every tree insertion is amortized O(1) with the end() hint.
+     * @param entries One entry per book (consumed)
+     */
+    void assign(std::vector<Entry> entries)
+    {
+        m_entries.clear();
+        Sorting::quickSort(entries, EntryLess());
+        for (Entry& entry : entries) {
+            m_entries.emplace_hint(m_entries.end(), std::move(entry));
+        }
+    }
+
+    /**
+     * @brief Remove all entries
+     */
+    void clear() { m_entries.clear(); }
+
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+    const_iterator begin() const { return m_entries.begin(); }
+    const_iterator end() const { return m_entries.end(); }
+    const_reverse_iterator rbegin() const { return m_entries.rbegin(); }
+    const_reverse_iterator rend() const { return m_entries.rend(); }
+
+    /**
+     * @brief First entry not ordered before probe - O(log n)
+     */
+    const_iterator lowerBound(const Entry& probe) const { return m_entries.lower_bound(probe); }
+
+    /**
+     * @brief Visit book IDs in index order
+     * @param ascending True walks smallest key first, false walks largest key first
+     * @param visit Callback taking the book ID; return false to stop early
+     */
+    template<typename Visitor>
+    void forEachId(bool ascending, Visitor visit) const
+    {
+        if (ascending) {
+            for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+                if (!visit(it->id)) return;
+            }
+        } else {
+            for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it) {
+                if (!visit(it->id)) return;
+            }
+        }
+    }
+
+private:
+    Container m_entries;  ///< Entries in sorted order
+};
+
+#endif // SECONDARYINDEX_H
@@ -2,20 +2,199 @@
 #define SORTING_H
 
 #include <vector>
+#include <utility>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <functional>
 
 /**
- * @brief QuickSort Algorithm Implementation (ONLY)
- * 
- * This header provides ONLY QuickSort algorithm - a highly efficient
- * divide-and-conquer sorting algorithm with O(n log n) average complexity.
- * 
- * Other sorting algorithms (Bubble, Selection, Merge) have been REMOVED
- * for code cleanliness and focus on the most efficient general-purpose algorithm.
+ * @brief Sorting algorithms used by BookManager and the UI
+ *
+ * - quickSort(): introsort-style QuickSort, the general-purpose sort.
+ *   Median-of-three (ninther for large ranges) pivots, three-way
+ *   partitioning so runs of equal keys (years, ratings) finish in one pass,
+ *   insertion sort for small ranges and a heapSort() fallback when the
+ *   recursion gets too deep.
+ * - mergeSort() / parallelMergeSort(): stable bottom-up MergeSort; the
+ *   parallel version sorts slices on worker threads and merges them, so
+ *   large catalogs sort on several cores with the same order on every run.
+ * - radixSort() / sortByKey(..., SortOrder): stable counting / LSD radix
+ *   sort for integer keys (years, fixed-point ratings), linear time.
+ * - decorate() / undecorate() / sortByKey(): compute a sort key once per
+ *   element instead of once per comparison.
+ * - sortIndices() / sortIndicesByKey(): sort positions into a vector
+ *   instead of the elements, for views over a shared collection.
+ * - topK(): bounded-heap selection of the k first elements, O(n log k).
  */
 namespace Sorting
 {
+    /// Ranges with at most this many elements are finished with insertion sort
+    constexpr int kInsertionSortThreshold = 16;
+
+    /// Ranges larger than this use Tukey's ninther instead of median-of-three
+    constexpr int kNintherThreshold = 128;
+
     /**
-     * @brief QuickSort algorithm implementation (Core recursive function)
+     * @brief Insertion sort on arr[left..right] (used for small partitions)
+     * @tparam T Type of elements to sort
+     * @tparam Compare Comparison function type
+     * @param arr Vector to sort
+     * @param left Starting index
+     * @param right Ending index (inclusive)
+     * @param compare Comparison function
+     * 
+     * Time Complexity: O(n²) worst, O(n) on nearly sorted input
+     */
+    template<typename T, typename Compare>
+    void insertionSort(std::vector<T>& arr, int left, int right, Compare compare)
+    {
+        for (int i = left + 1; i <= right; i++) {
+            if (!compare(arr[i], arr[i - 1])) continue;
+
+            T value = std::move(arr[i]);
+            int j = i;
+            do {
+                arr[j] = std::move(arr[j - 1]);
+                j--;
+            } while (j > left && compare(value, arr[j - 1]));
+            arr[j] = std::move(value);
+        }
+    }
+
+    /**
+     * @brief Restore the max-heap property for the heap stored at arr[base..base+count)
+     * @param root Heap-relative index of the element to sift down
+     * @param count Number of elements in the heap
+     */
+    template<typename T, typename Compare>
+    void siftDown(std::vector<T>& arr, int base, int root, int count, Compare compare)
+    {
+        T value = std::move(arr[base + root]);
+        while (true) {
+            int child = 2 * root + 1;
+            if (child >= count) break;
+            if (child + 1 < count && compare(arr[base + child], arr[base + child + 1])) {
+                child++;
+            }
+            if (!compare(value, arr[base + child])) break;
+            arr[base + root] = std::move(arr[base + child]);
+            root = child;
+        }
+        arr[base + root] = std::move(value);
+    }
+
+    /**
+     * @brief HeapSort on arr[left..right] (fallback when QuickSort recursion is too deep)
+     * 
+     * Time Complexity: O(n log n) guaranteed
+     * Space Complexity: O(1)
+     */
+    template<typename T, typename Compare>
+    void heapSort(std::vector<T>& arr, int left, int right, Compare compare)
+    {
+        int count = right - left + 1;
+        if (count < 2) return;
+
+        for (int i = count / 2 - 1; i >= 0; i--) {
+            siftDown(arr, left, i, count, compare);
+        }
+        for (int end = count - 1; end > 0; end--) {
+            std::swap(arr[left], arr[left + end]);
+            siftDown(arr, left, 0, end, compare);
+        }
+    }
+
+    /**
+     * @brief Order arr[a], arr[b], arr[c] so that arr[b] holds their median
+     */
+    template<typename T, typename Compare>
+    void sortThree(std::vector<T>& arr, int a, int b, int c, Compare compare)
+    {
+        if (compare(arr[b], arr[a])) std::swap(arr[a], arr[b]);
+        if (compare(arr[c], arr[b])) {
+            std::swap(arr[b], arr[c]);
+            if (compare(arr[b], arr[a])) std::swap(arr[a], arr[b]);
+        }
+    }
+
+    /**
+     * @brief Pick a pivot for arr[left..right] and return its index
+     * 
+     * Median-of-three for normal ranges, Tukey's ninther (median of three
+     * medians) for large ones. Already sorted or reversed input therefore
+     * splits evenly instead of degrading to O(n²).
+     */
+    template<typename T, typename Compare>
+    int choosePivot(std::vector<T>& arr, int left, int right, Compare compare)
+    {
+        int count = right - left + 1;
+        int mid = left + count / 2;
+
+        if (count > kNintherThreshold) {
+            int step = count / 8;
+            sortThree(arr, left, left + step, left + 2 * step, compare);
+            sortThree(arr, mid - step, mid, mid + step, compare);
+            sortThree(arr, right - 2 * step, right - step, right, compare);
+            sortThree(arr, left + step, mid, right - step, compare);
+        } else {
+            sortThree(arr, left, mid, right, compare);
+        }
+        return mid;
+    }
+
+    /**
+     * @brief Introsort main loop (QuickSort with depth limit)
+     * 
+     * Partitions three ways around the pivot: [< pivot][== pivot][> pivot].
+     * The pivot is kept in place at arr[lt] instead of being copied out, the
+     * smaller side is handled recursively and the larger side by looping, so
+     * the stack depth stays O(log n).
+     */
+    template<typename T, typename Compare>
+    void introSortLoop(std::vector<T>& arr, int left, int right, int depthLimit, Compare compare)
+    {
+        while (right - left + 1 > kInsertionSortThreshold) {
+            if (depthLimit == 0) {
+                heapSort(arr, left, right, compare);
+                return;
+            }
+            depthLimit--;
+
+            int pivotIndex = choosePivot(arr, left, right, compare);
+            std::swap(arr[left], arr[pivotIndex]);
+
+            // Invariant: arr[left..lt-1] < pivot, arr[lt..i-1] == pivot, arr[gt+1..right] > pivot
+            int lt = left;
+            int i = left + 1;
+            int gt = right;
+            while (i <= gt) {
+                if (compare(arr[i], arr[lt])) {
+                    std::swap(arr[lt], arr[i]);
+                    lt++;
+                    i++;
+                } else if (compare(arr[lt], arr[i])) {
+                    std::swap(arr[i], arr[gt]);
+                    gt--;
+                } else {
+                    i++;
+                }
+            }
+
+            if (lt - left < right - gt) {
+                introSortLoop(arr, left, lt - 1, depthLimit, compare);
+                left = gt + 1;
+            } else {
+                introSortLoop(arr, gt + 1, right, depthLimit, compare);
+                right = lt - 1;
+            }
+        }
+        insertionSort(arr, left, right, compare);
+    }
+
+    /**
+     * @brief QuickSort algorithm implementation (Core function)
      * @tparam T Type of elements to sort
      * @tparam Compare Comparison function type (supports lambdas)
      * @param arr Vector to sort
@@ -25,32 +204,22 @@ namespace Sorting
      * 
      * Time Complexity:
      * - Average: O(n log n)
-     * - Worst: O(n²) - rare with good pivot selection
-     * - Best: O(n log n)
+     * - Worst: O(n log n) - heapsort fallback after 2·log2(n) levels
+     * - Best: O(n) when all keys are equal (three-way partition)
      * 
-     * Space Complexity: O(log n) due to recursion stack
+     * Space Complexity: O(log n) - only the smaller partition recurses
      */
     template<typename T, typename Compare>
     void quickSort(std::vector<T>& arr, int left, int right, Compare compare)
     {
-        if (left >= right) return;
-
-        // Partition phase
-        T pivot = arr[right];
-        int i = left - 1;
+        if (left < 0 || left >= right) return;
 
-        for (int j = left; j < right; j++) {
-            if (compare(arr[j], pivot)) {
-                i++;
-                std::swap(arr[i], arr[j]);
-            }
+        int depthLimit = 0;
+        for (int n = right - left + 1; n > 1; n >>= 1) {
+            depthLimit += 2;
         }
-        std::swap(arr[i + 1], arr[right]);
-        int pivotIndex = i + 1;
 
-        // Recursive calls on sub-arrays
-        quickSort(arr, left, pivotIndex - 1, compare);
-        quickSort(arr, pivotIndex + 1, right, compare);
+        introSortLoop(arr, left, right, depthLimit, compare);
     }
 
     /**
@@ -87,6 +256,511 @@ namespace Sorting
         quickSort(arr, 0, arr.size() - 1, compare);
     }
 
+    // ========================================================================
+    // STABLE MERGE SORT - Multi-threaded path for large collections
+    // ========================================================================
+
+    /// Runs of this size are insertion-sorted before merging starts
+    constexpr int kMergeRunSize = 32;
+
+    /// parallelMergeSort never gives a worker fewer elements than this
+    constexpr size_t kMinParallelChunk = 8192;
+
+    /**
+     * @brief Merge src[left..mid) and src[mid..right) into dst[left..right)
+     * 
+     * On equal keys the element from the left run wins, which keeps the
+     * merge stable.
+     */
+    template<typename T, typename Compare>
+    void mergeRuns(std::vector<T>& src, std::vector<T>& dst,
+                   size_t left, size_t mid, size_t right, Compare compare)
+    {
+        size_t i = left;
+        size_t j = mid;
+        size_t k = left;
+
+        while (i < mid && j < right) {
+            if (compare(src[j], src[i])) {
+                dst[k++] = std::move(src[j++]);
+            } else {
+                dst[k++] = std::move(src[i++]);
+            }
+        }
+        while (i < mid) dst[k++] = std::move(src[i++]);
+        while (j < right) dst[k++] = std::move(src[j++]);
+    }
+
+    /**
+     * @brief Stable bottom-up MergeSort of arr[left..right) using buffer as scratch space
+     * @param buffer Scratch vector, at least arr.size() elements
+     * 
+     * Time Complexity: O(n log n) guaranteed
+     * Space Complexity: O(n) (the caller-provided buffer)
+     */
+    template<typename T, typename Compare>
+    void mergeSort(std::vector<T>& arr, std::vector<T>& buffer,
+                   size_t left, size_t right, Compare compare)
+    {
+        if (right - left < 2) return;
+
+        for (size_t runStart = left; runStart < right; runStart += kMergeRunSize) {
+            size_t runEnd = std::min(runStart + kMergeRunSize, right);
+            insertionSort(arr, static_cast<int>(runStart), static_cast<int>(runEnd) - 1, compare);
+        }
+
+        std::vector<T>* src = &arr;
+        std::vector<T>* dst = &buffer;
+        for (size_t width = kMergeRunSize; width < right - left; width *= 2) {
+            for (size_t lo = left; lo < right; lo += 2 * width) {
+                size_t mid = std::min(lo + width, right);
+                size_t hi = std::min(lo + 2 * width, right);
+                mergeRuns(*src, *dst, lo, mid, hi, compare);
+            }
+            std::swap(src, dst);
+        }
+
+        if (src != &arr) {
+            std::move(buffer.begin() + left, buffer.begin() + right, arr.begin() + left);
+        }
+    }
+
+    /**
+     * @brief Stable MergeSort (convenience version)
+     * @tparam T Type of elements (must be default-constructible)
+     * @param arr Vector to sort
+     * @param compare Comparison function
+     */
+    template<typename T, typename Compare>
+    void mergeSort(std::vector<T>& arr, Compare compare)
+    {
+        std::vector<T> buffer(arr.size());
+        mergeSort(arr, buffer, 0, arr.size(), compare);
+    }
+
+    /**
+     * @brief Multi-threaded stable MergeSort
+     * @tparam T Type of elements (must be default-constructible)
+     * @tparam Compare Comparison function type
+     * @param arr Vector to sort
+     * @param compare Comparison function
+     * @param workerCount Number of threads to use (0 = all hardware threads)
+     * 
+     * The vector is split into one chunk per worker, every chunk is sorted
+     * on its own thread, then neighbouring runs are merged pairwise (again in
+     * parallel) until one run is left. Because the sort is stable the result
+     * does not depend on the number of workers.
+     * 
+     * Time Complexity: O(n log n / p + n log p) with p workers
+     * Space Complexity: O(n)
+     */
+    template<typename T, typename Compare>
+    void parallelMergeSort(std::vector<T>& arr, Compare compare, int workerCount = 0)
+    {
+        size_t n = arr.size();
+        if (n < 2) return;
+
+        size_t workers = workerCount > 0
+            ? static_cast<size_t>(workerCount)
+            : std::max(1u, std::thread::hardware_concurrency());
+        workers = std::min(workers, std::max<size_t>(1, n / kMinParallelChunk));
+
+        std::vector<T> buffer(n);
+        if (workers == 1) {
+            mergeSort(arr, buffer, 0, n, compare);
+            return;
+        }
+
+        // 1. Sort one chunk per worker
+        std::vector<size_t> bounds(workers + 1);
+        for (size_t w = 0; w <= workers; w++) {
+            bounds[w] = n * w / workers;
+        }
+
+        std::vector<std::thread> threads;
+        for (size_t w = 1; w < workers; w++) {
+            threads.emplace_back([&arr, &buffer, &bounds, compare, w]() {
+                mergeSort(arr, buffer, bounds[w], bounds[w + 1], compare);
+            });
+        }
+        mergeSort(arr, buffer, bounds[0], bounds[1], compare);
+        for (std::thread& t : threads) t.join();
+
+        // 2. Merge neighbouring runs pairwise, one thread per pair
+        std::vector<T>* src = &arr;
+        std::vector<T>* dst = &buffer;
+        while (bounds.size() > 2) {
+            std::vector<size_t> merged;
+            threads.clear();
+
+            for (size_t r = 0; r + 1 < bounds.size(); r += 2) {
+                size_t lo = bounds[r];
+                if (r + 2 < bounds.size()) {
+                    size_t mid = bounds[r + 1];
+                    size_t hi = bounds[r + 2];
+                    threads.emplace_back([src, dst, lo, mid, hi, compare]() {
+                        mergeRuns(*src, *dst, lo, mid, hi, compare);
+                    });
+                } else {
+                    // Odd run out: carry it over unchanged
+                    std::move(src->begin() + lo, src->begin() + bounds[r + 1], dst->begin() + lo);
+                }
+                merged.push_back(lo);
+            }
+            merged.push_back(n);
+
+            for (std::thread& t : threads) t.join();
+            bounds.swap(merged);
+            std::swap(src, dst);
+        }
+
+        if (src != &arr) {
+            std::move(buffer.begin(), buffer.end(), arr.begin());
+        }
+    }
+
+    // ========================================================================
+    // KEY EXTRACTION - Decorate / sort / undecorate
+    // ========================================================================
+
+    /**
+     * @brief Precomputed sort key paired with the element's original position
+     * @tparam K Key type
+     */
+    template<typename K>
+    struct KeyedIndex {
+        K key;
+        uint32_t index;
+    };
+
+    /**
+     * @brief Build one KeyedIndex per element (the "decorate" step)
+     * @param arr Elements to decorate
+     * @param getKey Key extractor, called exactly once per element
+     * @return Vector of (key, original index) pairs in input order
+     */
+    template<typename T, typename KeyFn>
+    auto decorate(const std::vector<T>& arr, KeyFn getKey)
+        -> std::vector<KeyedIndex<std::decay_t<decltype(getKey(arr[0]))>>>
+    {
+        std::vector<KeyedIndex<std::decay_t<decltype(getKey(arr[0]))>>> keys;
+        keys.reserve(arr.size());
+        for (size_t i = 0; i < arr.size(); i++) {
+            keys.push_back({getKey(arr[i]), static_cast<uint32_t>(i)});
+        }
+        return keys;
+    }
+
+    /**
+     * @brief Turn a key comparator into a comparator on KeyedIndex
+     *
+     * Equal keys fall back to the original index, which makes any sort of
+     * the decorated vector stable.
+     */
+    template<typename KeyCompare>
+    auto keyedCompare(KeyCompare compareKeys)
+    {
+        return [compareKeys](const auto& a, const auto& b) {
+            if (compareKeys(a.key, b.key)) return true;
+            if (compareKeys(b.key, a.key)) return false;
+            return a.index < b.index;
+        };
+    }
+
+    /**
+     * @brief Reorder arr to match sorted keys (the "undecorate" step)
+     * @param arr Elements in their original order, reordered in place
+     * @param keys Sorted decorated keys produced by decorate()
+     *
+     * Every element is moved exactly once; nothing is copied.
+     */
+    template<typename T, typename K>
+    void undecorate(std::vector<T>& arr, const std::vector<KeyedIndex<K>>& keys)
+    {
+        std::vector<T> result;
+        result.reserve(arr.size());
+        for (const KeyedIndex<K>& entry : keys) {
+            result.push_back(std::move(arr[entry.index]));
+        }
+        arr.swap(result);
+    }
+
+    /**
+     * @brief Sort by a precomputed key (decorate - sort - undecorate)
+     * @tparam T Type of elements
+     * @tparam KeyFn Key extractor type
+     * @tparam KeyCompare Comparison function type on keys
+     * @param arr Vector to sort
+     * @param getKey Key extractor (called n times instead of 2 per comparison)
+     * @param compareKeys Comparison function on keys
+     *
+     * Use this when building the key is expensive (lowercasing a QString,
+     * collation): the key is computed once per element, so the extra work is
+     * O(n) instead of O(n log n). The sort is stable.
+     *
+     * Usage:
+     * Sorting::sortByKey(books,
+     *     [](const Book& b) { return b.getJudul().toLower(); },
+     *     [](const QString& a, const QString& b) { return a < b; });
+     */
+    template<typename T, typename KeyFn, typename KeyCompare>
+    void sortByKey(std::vector<T>& arr, KeyFn getKey, KeyCompare compareKeys)
+    {
+        if (arr.size() < 2) return;
+
+        auto keys = decorate(arr, getKey);
+        quickSort(keys, keyedCompare(compareKeys));
+        undecorate(arr, keys);
+    }
+
+    // ========================================================================
+    // INDEX SORTING - Sort positions, leave the elements where they are
+    // ========================================================================
+
+    /**
+     * @brief Sort positions into arr instead of the elements themselves
+     * @param arr Element store (not modified)
+     * @param indices Positions into arr, reordered in place
+     * @param compare Comparison function on elements
+     *
+     * Only 4-byte indices are swapped, so heavy elements (Book) are never
+     * copied or moved.
+     */
+    template<typename T, typename Compare>
+    void sortIndices(const std::vector<T>& arr, std::vector<uint32_t>& indices, Compare compare)
+    {
+        quickSort(indices, [&arr, compare](uint32_t a, uint32_t b) {
+            return compare(arr[a], arr[b]);
+        });
+    }
+
+    /**
+     * @brief Keep only the k elements that sort first, in sorted order
+     * @param arr Vector to select from; shrunk to min(k, size) elements
+     * @param k Number of elements to keep
+     * @param compare Comparison function (true if a sorts before b)
+     *
+     * Bounded heap selection: arr[0..k) is kept as a max-heap of the best k
+     * seen so far (root = the one that sorts last), each later element
+     * either replaces the root or is skipped, and the survivors are finally
+     * heap-sorted. Much cheaper than a full sort when k is small.
+     *
+     * Time Complexity: O(n log k)
+     * Space Complexity: O(1)
+     */
+    template<typename T, typename Compare>
+    void topK(std::vector<T>& arr, size_t k, Compare compare)
+    {
+        if (k == 0) {
+            arr.clear();
+            return;
+        }
+        if (arr.size() <= k) {
+            quickSort(arr, compare);
+            return;
+        }
+
+        int count = static_cast<int>(k);
+        for (int i = count / 2 - 1; i >= 0; i--) {
+            siftDown(arr, 0, i, count, compare);
+        }
+        for (size_t i = k; i < arr.size(); i++) {
+            if (compare(arr[i], arr[0])) {
+                std::swap(arr[0], arr[i]);
+                siftDown(arr, 0, 0, count, compare);
+            }
+        }
+        arr.resize(k);
+        heapSort(arr, 0, count - 1, compare);
+    }
+
+    /**
+     * @brief Build the keys for a subset of arr (decorate step for index sorting)
+     * @param arr Element store (not modified)
+     * @param indices Positions into arr to decorate
+     * @param getKey Key extractor, called once per index
+     * @return Vector of (key, position in arr) pairs
+     */
+    template<typename T, typename KeyFn>
+    auto decorateIndices(const std::vector<T>& arr, const std::vector<uint32_t>& indices, KeyFn getKey)
+        -> std::vector<KeyedIndex<std::decay_t<decltype(getKey(arr[0]))>>>
+    {
+        std::vector<KeyedIndex<std::decay_t<decltype(getKey(arr[0]))>>> keys;
+        keys.reserve(indices.size());
+        for (uint32_t index : indices) {
+            keys.push_back({getKey(arr[index]), index});
+        }
+        return keys;
+    }
+
+    /**
+     * @brief Sort positions into arr by a key computed once per position
+     * @param arr Element store (not modified)
+     * @param indices Positions into arr, reordered in place
+     * @param getKey Key extractor
+     * @param compareKeys Comparison function on keys
+     */
+    template<typename T, typename KeyFn, typename KeyCompare>
+    void sortIndicesByKey(const std::vector<T>& arr, std::vector<uint32_t>& indices,
+                          KeyFn getKey, KeyCompare compareKeys)
+    {
+        if (indices.size() < 2) return;
+
+        auto keys = decorateIndices(arr, indices, getKey);
+        quickSort(keys, keyedCompare(compareKeys));
+        for (size_t i = 0; i < keys.size(); i++) {
+            indices[i] = keys[i].index;
+        }
+    }
+
+    // ========================================================================
+    // RADIX / COUNTING SORT - Linear-time path for integer keys
+    // ========================================================================
+
+    /**
+     * @brief Sort direction for key-extractor sorts
+     */
+    enum class SortOrder { Ascending, Descending };
+
+    /// Key ranges smaller than this are sorted with a single counting pass
+    constexpr uint64_t kCountingSortMaxRange = 1u << 16;
+
+    /**
+     * @brief Map an integer key to an unsigned key with the same ordering
+     *
+     * Signed keys get their sign bit flipped so negative values sort first.
+     */
+    template<typename K>
+    std::make_unsigned_t<K> toOrderedUnsigned(K key)
+    {
+        using U = std::make_unsigned_t<K>;
+        if constexpr (std::is_signed_v<K>) {
+            return static_cast<U>(key) ^ (U(1) << (sizeof(K) * 8 - 1));
+        } else {
+            return key;
+        }
+    }
+
+    /**
+     * @brief Stable counting / LSD radix sort of decorated integer keys
+     * @tparam K Integral key type
+     * @param keys Decorated keys, sorted in place
+     * @param order Ascending or Descending
+     *
+     * Keys are rebased to (key - min). If the remaining range is small
+     * (years, ratings in fixed point) a single counting pass finishes the
+     * job; otherwise an LSD radix sort runs over 8-bit digits, only for as
+     * many bytes as the range needs, skipping digits that are equal for
+     * every key. Equal keys keep their relative order.
+     *
+     * Time Complexity: O(n + range) counting, O(n · bytes) radix
+     * Space Complexity: O(n)
+     */
+    template<typename K>
+    void radixSort(std::vector<KeyedIndex<K>>& keys, SortOrder order = SortOrder::Ascending)
+    {
+        static_assert(std::is_integral_v<K>, "radixSort requires an integral key");
+        using U = std::make_unsigned_t<K>;
+
+        size_t n = keys.size();
+        if (n < 2) return;
+
+        auto digitsOf = [order](K key) -> U {
+            U value = toOrderedUnsigned(key);
+            return order == SortOrder::Ascending ? value : static_cast<U>(~value);
+        };
+
+        U minValue = digitsOf(keys[0].key);
+        U maxValue = minValue;
+        for (const KeyedIndex<K>& entry : keys) {
+            U value = digitsOf(entry.key);
+            if (value < minValue) minValue = value;
+            if (value > maxValue) maxValue = value;
+        }
+        if (minValue == maxValue) return;
+
+        uint64_t range = static_cast<uint64_t>(maxValue - minValue);
+        std::vector<KeyedIndex<K>> buffer(n);
+
+        if (range < kCountingSortMaxRange) {
+            // Counting sort: one histogram, one scatter pass
+            std::vector<size_t> counts(static_cast<size_t>(range) + 2, 0);
+            for (const KeyedIndex<K>& entry : keys) {
+                counts[static_cast<size_t>(digitsOf(entry.key) - minValue) + 1]++;
+            }
+            for (size_t i = 1; i < counts.size(); i++) {
+                counts[i] += counts[i - 1];
+            }
+            for (KeyedIndex<K>& entry : keys) {
+                buffer[counts[static_cast<size_t>(digitsOf(entry.key) - minValue)]++] = std::move(entry);
+            }
+            keys.swap(buffer);
+            return;
+        }
+
+        // LSD radix sort over the bytes that the range actually uses
+        int bytes = 0;
+        for (uint64_t r = range; r != 0; r >>= 8) bytes++;
+
+        for (int pass = 0; pass < bytes; pass++) {
+            int shift = pass * 8;
+            size_t counts[257] = {0};
+            for (const KeyedIndex<K>& entry : keys) {
+                counts[((static_cast<uint64_t>(digitsOf(entry.key) - minValue) >> shift) & 0xFF) + 1]++;
+            }
+
+            // All keys share this digit: the pass would not change anything
+            bool trivial = false;
+            for (int d = 1; d <= 256; d++) {
+                if (counts[d] == n) { trivial = true; break; }
+            }
+            if (trivial) continue;
+
+            for (int d = 1; d <= 256; d++) {
+                counts[d] += counts[d - 1];
+            }
+            for (KeyedIndex<K>& entry : keys) {
+                size_t digit = (static_cast<uint64_t>(digitsOf(entry.key) - minValue) >> shift) & 0xFF;
+                buffer[counts[digit]++] = std::move(entry);
+            }
+            keys.swap(buffer);
+        }
+    }
+
+    /**
+     * @brief Sort by key with the algorithm chosen from the key type
+     * @tparam T Type of elements
+     * @tparam KeyFn Key extractor type
+     * @param arr Vector to sort
+     * @param getKey Key extractor (called once per element)
+     * @param order Ascending or Descending
+     *
+     * Integral keys (years, IDs, fixed-point ratings) are sorted with the
+     * linear-time radixSort(); any other key type falls back to QuickSort on
+     * the decorated keys. Both paths are stable.
+     *
+     * Usage:
+     * Sorting::sortByKey(books, [](const Book& b) { return b.getTahun(); },
+     *                    Sorting::SortOrder::Descending);
+     */
+    template<typename T, typename KeyFn>
+    void sortByKey(std::vector<T>& arr, KeyFn getKey, SortOrder order)
+    {
+        if (arr.size() < 2) return;
+
+        using K = std::decay_t<decltype(getKey(arr[0]))>;
+        auto keys = decorate(arr, getKey);
+
+        if constexpr (std::is_integral_v<K>) {
+            radixSort(keys, order);
+        } else if (order == SortOrder::Ascending) {
+            quickSort(keys, keyedCompare(std::less<K>()));
+        } else {
+            quickSort(keys, keyedCompare(std::greater<K>()));
+        }
+        undecorate(arr, keys);
+    }
+
 } // namespace Sorting
 
 #endif // SORTING_H
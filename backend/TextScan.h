@@ -0,0 +1,343 @@
+#ifndef TEXTSCAN_H
+#define TEXTSCAN_H
+
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TEXTSCAN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+/**
+ * @brief Vectorized substring search over UTF-16 text
+ *
+ * Case-insensitivity comes from folding once: texts are stored lowercased
+ * (QString::toLower, full Unicode) and the needle is lowercased too, so
+ * the hot loop is an exact UTF-16 match. The kernels compare the first
+ * and the last needle unit against 8 (SSE2) or 16 (AVX2) haystack
+ * positions per step and only verify positions where both agree, so a
+ * scan touches each haystack unit about twice. The widest kernel the CPU
+ * supports is picked once at runtime; other CPUs use the scalar loop.
+ */
+namespace TextScan
+{
+    enum class Level { Scalar, SSE2, AVX2 };
+
+    namespace detail
+    {
+        inline bool restMatches(const ushort* at, const ushort* needle, size_t m)
+        {
+            return m <= 2 || std::memcmp(at + 1, needle + 1, (m - 2) * sizeof(ushort)) == 0;
+        }
+
+        inline uint32_t lowestBit(uint32_t mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<uint32_t>(index);
+#else
+            return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+        }
+
+        inline size_t findScalar(const ushort* h, size_t n, const ushort* needle, size_t m, size_t from)
+        {
+            ushort first = needle[0];
+            ushort last = needle[m - 1];
+            for (size_t i = from; i + m <= n; i++) {
+                if (h[i] == first && h[i + m - 1] == last && restMatches(h + i, needle, m)) return i;
+            }
+            return n;
+        }
+
+#if defined(TEXTSCAN_X86)
+#if defined(__GNUC__) || defined(__clang__)
+        __attribute__((target("sse2")))
+#endif
+        inline size_t findSSE2(const ushort* h, size_t n, const ushort* needle, size_t m, size_t from)
+        {
+            const __m128i first = _mm_set1_epi16(static_cast<short>(needle[0]));
+            const __m128i last = _mm_set1_epi16(static_cast<short>(needle[m - 1]));
+            size_t i = from;
+            for (; i + m - 1 + 8 <= n; i += 8) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + m - 1));
+                __m128i hits = _mm_and_si128(_mm_cmpeq_epi16(a, first), _mm_cmpeq_epi16(b, last));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));  // 2 bits per lane
+                while (mask != 0) {
+                    uint32_t lane = lowestBit(mask) / 2;
+                    if (restMatches(h + i + lane, needle, m)) return i + lane;
+                    mask &= ~(3u << (lane * 2));
+                }
+            }
+            return findScalar(h, n, needle, m, i);
+        }
+
+#if defined(__GNUC__) || defined(__clang__)
+        __attribute__((target("avx2")))
+#endif
+        inline size_t findAVX2(const ushort* h, size_t n, const ushort* needle, size_t m, size_t from)
+        {
+            const __m256i first = _mm256_set1_epi16(static_cast<short>(needle[0]));
+            const __m256i last = _mm256_set1_epi16(static_cast<short>(needle[m - 1]));
+            size_t i = from;
+            for (; i + m - 1 + 16 <= n; i += 16) {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i + m - 1));
+                __m256i hits = _mm256_and_si256(_mm256_cmpeq_epi16(a, first), _mm256_cmpeq_epi16(b, last));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+                while (mask != 0) {
+                    uint32_t lane = lowestBit(mask) / 2;
+                    if (restMatches(h + i + lane, needle, m)) return i + lane;
+                    mask &= ~(3u << (lane * 2));
+                }
+            }
+            return findScalar(h, n, needle, m, i);
+        }
+#endif
+
+        inline Level detectLevel()
+        {
+#if defined(TEXTSCAN_X86) && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] >= 7) {
+                __cpuidex(info, 7, 0);
+                bool avx2 = (info[1] & (1 << 5)) != 0;
+                __cpuid(info, 1);
+                bool osxsave = (info[2] & (1 << 27)) != 0;
+                if (avx2 && osxsave && (_xgetbv(0) & 6) == 6) return Level::AVX2;
+            }
+            return Level::SSE2;
+#elif defined(TEXTSCAN_X86)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+            if (__builtin_cpu_supports("sse2")) return Level::SSE2;
+            return Level::Scalar;
+#else
+            return Level::Scalar;
+#endif
+        }
+
+        using FindFn = size_t (*)(const ushort*, size_t, const ushort*, size_t, size_t);
+
+        inline FindFn kernelFor(Level level)
+        {
+#if defined(TEXTSCAN_X86)
+            if (level == Level::AVX2) return findAVX2;
+            if (level == Level::SSE2) return findSSE2;
+#else
+            (void)level;
+#endif
+            return findScalar;
+        }
+
+        inline FindFn& activeKernel()
+        {
+            static FindFn kernel = kernelFor(detectLevel());
+            return kernel;
+        }
+    }
+
+    /**
+     * @brief Widest kernel this CPU supports (detected once)
+     */
+    inline Level supportedLevel()
+    {
+        static const Level level = detail::detectLevel();
+        return level;
+    }
+
+    /**
+     * @brief Force a kernel (benchmarks/tests); levels the CPU lacks fall back to the best supported one
+     * Not thread-safe: call it only while no scan is running.
+     */
+    inline void setLevel(Level level)
+    {
+        if (static_cast<int>(level) > static_cast<int>(supportedLevel())) level = supportedLevel();
+        detail::activeKernel() = detail::kernelFor(level);
+    }
+
+    inline const char* levelName(Level level)
+    {
+        switch (level) {
+            case Level::AVX2: return "AVX2";
+            case Level::SSE2: return "SSE2";
+            case Level::Scalar: break;
+        }
+        return "scalar";
+    }
+
+    /**
+     * @brief First occurrence of a needle in a haystack (exact UTF-16 match)
+     * @param haystack Haystack units
+     * @param n Haystack length
+     * @param needle Needle units
+     * @param m Needle length
+     * @param from First position to consider
+     * @return Position of the match, or n if there is none
+     */
+    inline size_t find(const ushort* haystack, size_t n, const ushort* needle, size_t m, size_t from = 0)
+    {
+        if (m == 0) return from <= n ? from : n;
+        if (m > n || from > n - m) return n;
+        return detail::activeKernel()(haystack, n, needle, m, from);
+    }
+
+    /**
+     * @brief Whether a folded text contains a folded needle
+     */
+    inline bool contains(const QString& foldedText, const QString& foldedNeedle)
+    {
+        size_t n = static_cast<size_t>(foldedText.size());
+        return find(foldedText.utf16(), n, foldedNeedle.utf16(), static_cast<size_t>(foldedNeedle.size())) != n
+            || foldedNeedle.isEmpty();
+    }
+
+    /**
+     * @brief Folded texts of many books packed into one contiguous buffer
+     *
+     * A fragment scan is then a single pass of find() over the buffer
+     * instead of one call per book; every hit is mapped back to its book
+     * and the scan resumes after that book's text. Texts are separated by
+     * U+FFFF (a noncharacter) so a match cannot span two books. Erased
+     * texts leave a hole that is reclaimed once holes outweigh live text.
+     */
+    class PackedTexts
+    {
+    public:
+        /**
+         * @brief Add or replace the text of one book
+         * @param id Book ID
+         * @param folded Text already lowercased by the caller
+         */
+        void insert(int id, const QString& folded)
+        {
+            erase(id);
+            Span span{id, static_cast<uint32_t>(m_buffer.size()), static_cast<uint32_t>(folded.size())};
+            const ushort* units = folded.utf16();
+            m_buffer.insert(m_buffer.end(), units, units + folded.size());
+            m_buffer.push_back(kSeparator);
+            m_spanOf[id] = m_spans.size();
+            m_spans.push_back(span);
+            m_liveUnits += span.length + 1;
+        }
+
+        /**
+         * @brief Remove the text of one book
+         * @return true if the book was stored
+         */
+        bool erase(int id)
+        {
+            auto it = m_spanOf.find(id);
+            if (it == m_spanOf.end()) return false;
+            Span& span = m_spans[it->second];
+            m_liveUnits -= span.length + 1;
+            span.id = kDead;
+            m_spanOf.erase(it);
+            if (m_buffer.size() > kCompactMinimum && m_liveUnits * 2 < m_buffer.size()) compact();
+            return true;
+        }
+
+        void clear()
+        {
+            m_buffer.clear();
+            m_spans.clear();
+            m_spanOf.clear();
+            m_liveUnits = 0;
+        }
+
+        void reserve(size_t texts, size_t units)
+        {
+            m_spans.reserve(texts);
+            m_spanOf.reserve(texts);
+            m_buffer.reserve(units);
+        }
+
+        /**
+         * @brief Books whose text contains a needle
+         * @param foldedNeedle Needle already lowercased by the caller
+         * @return Matching book IDs in ascending order
+         */
+        std::vector<int> findContaining(const QString& foldedNeedle) const
+        {
+            std::vector<int> ids;
+            const ushort* needle = foldedNeedle.utf16();
+            size_t m = static_cast<size_t>(foldedNeedle.size());
+            size_t n = m_buffer.size();
+            size_t span = 0;
+            size_t pos = 0;
+            while (span < m_spans.size()) {
+                pos = find(m_buffer.data(), n, needle, m, pos);
+                if (pos == n) break;
+                // Spans are ordered by start: advance to the first one the match fits in
+                while (span < m_spans.size() && m_spans[span].start + m_spans[span].length < pos + m) span++;
+                if (span == m_spans.size()) break;
+                const Span& hit = m_spans[span];
+                if (pos < hit.start) {
+                    pos++;  // Needle contains the separator and straddles two texts
+                    continue;
+                }
+                if (hit.id != kDead) ids.push_back(hit.id);
+                pos = hit.start + hit.length + 1;  // One hit per book is enough
+                span++;
+            }
+            std::sort(ids.begin(), ids.end());
+            return ids;
+        }
+
+        size_t size() const { return m_spanOf.size(); }
+
+        /**
+         * @brief Bytes a full scan reads (for throughput figures)
+         */
+        size_t bytes() const { return m_buffer.size() * sizeof(ushort); }
+
+    private:
+        static constexpr ushort kSeparator = 0xFFFF;
+        static constexpr int kDead = -1;
+        static constexpr size_t kCompactMinimum = 4096;  ///< Never compact tiny buffers
+
+        struct Span {
+            int id;           ///< Book ID, kDead once erased
+            uint32_t start;   ///< First unit in m_buffer
+            uint32_t length;  ///< Units, separator excluded
+        };
+
+        std::vector<ushort> m_buffer;
+        std::vector<Span> m_spans;                 ///< Ordered by start
+        std::unordered_map<int, size_t> m_spanOf;  ///< Book ID -> index in m_spans
+        size_t m_liveUnits = 0;
+
+        void compact()
+        {
+            std::vector<ushort> buffer;
+            std::vector<Span> spans;
+            buffer.reserve(m_liveUnits);
+            spans.reserve(m_spanOf.size());
+            m_spanOf.clear();
+            for (const Span& span : m_spans) {
+                if (span.id == kDead) continue;
+                Span moved{span.id, static_cast<uint32_t>(buffer.size()), span.length};
+                buffer.insert(buffer.end(), m_buffer.begin() + span.start,
+                              m_buffer.begin() + span.start + span.length + 1);
+                m_spanOf[span.id] = spans.size();
+                spans.push_back(moved);
+            }
+            m_buffer.swap(buffer);
+            m_spans.swap(spans);
+        }
+    };
+}
+
+#endif // TEXTSCAN_H
@@ -0,0 +1,285 @@
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include "Searching.h"
+#include "TextScan.h"
+#include <QString>
+#include <QtGlobal>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief Case-folded trigram index answering "text contains fragment" queries
+ *
+ * Every indexed text (one per book ID) is lowercased and split into
+ * overlapping 3-character grams; each gram keeps a sorted posting list of
+ * book IDs. A query intersects the posting lists of the fragment's grams,
+ * starting from the shortest, and then verifies the few survivors with
+ * QString::contains, so its cost follows the number of candidates rather
+ * than the catalog size. Fragments shorter than 3 characters have no gram
+ * and fall back to one vectorized scan of all texts (see TextScan).
+ */
+class TrigramIndex
+{
+public:
+    /**
+     * @brief Add or replace the text of one book
+     * @param id Book ID
+     * @param text Text to index (folded here)
+     */
+    void insert(int id, const QString& text)
+    {
+        if (m_texts.count(id)) erase(id);
+        QString folded = text.toLower();
+        for (quint64 gram : gramsOf(folded)) {
+            std::vector<int>& ids = m_postings[gram];
+            // New books usually get the highest ID, so this is normally an append
+            auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+            if (pos == ids.end() || *pos != id) ids.insert(pos, id);
+        }
+        m_packed.insert(id, folded);
+        m_texts.emplace(id, std::move(folded));
+    }
+
+    /**
+     * @brief Remove one book from the index
+     * @param id Book ID
+     * @return true if the book was indexed
+     */
+    bool erase(int id)
+    {
+        auto it = m_texts.find(id);
+        if (it == m_texts.end()) return false;
+        for (quint64 gram : gramsOf(it->second)) {
+            auto posting = m_postings.find(gram);
+            if (posting == m_postings.end()) continue;
+            std::vector<int>& ids = posting->second;
+            auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+            if (pos != ids.end() && *pos == id) ids.erase(pos);
+            if (ids.empty()) m_postings.erase(posting);
+        }
+        m_packed.erase(id);
+        m_texts.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief Rebuild the whole index
+     * Posting lists are filled by appending and sorted once at the end.
+     * @param items (book ID, text) pairs
+     */
+    void assign(const std::vector<std::pair<int, QString>>& items)
+    {
+        clear();
+        m_texts.reserve(items.size());
+        size_t units = 0;
+        for (const auto& item : items) units += item.second.size() + 1;
+        m_packed.reserve(items.size(), units);
+        for (const auto& item : items) {
+            QString folded = item.second.toLower();
+            for (quint64 gram : gramsOf(folded)) {
+                m_postings[gram].push_back(item.first);
+            }
+            m_packed.insert(item.first, folded);
+            m_texts[item.first] = std::move(folded);
+        }
+        for (auto& posting : m_postings) {
+            std::vector<int>& ids = posting.second;
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        }
+    }
+
+    /**
+     * @brief Remove everything
+     */
+    void clear()
+    {
+        m_postings.clear();
+        m_texts.clear();
+        m_packed.clear();
+    }
+
+    /**
+     * @brief Find books whose text contains a fragment (case-insensitive)
+     * @param fragment Fragment to look for
+     * @return Matching book IDs in ascending order
+     */
+    std::vector<int> findContaining(const QString& fragment) const
+    {
+        QString needle = fragment.toLower();
+        std::vector<int> result;
+
+        std::vector<quint64> grams = gramsOf(needle);
+        if (grams.empty()) {
+            // 0-2 characters: no gram to narrow by, one vectorized pass over all texts
+            return m_packed.findContaining(needle);
+        }
+
+        // Collect posting lists; any missing gram means no match at all
+        std::vector<const std::vector<int>*> lists;
+        lists.reserve(grams.size());
+        for (quint64 gram : grams) {
+            auto posting = m_postings.find(gram);
+            if (posting == m_postings.end()) return result;
+            lists.push_back(&posting->second);
+        }
+        std::sort(lists.begin(), lists.end(),
+                  [](const std::vector<int>* a, const std::vector<int>* b) { return a->size() < b->size(); });
+
+        // Intersect, shortest list first. Once only a handful of candidates
+        // remain, verifying them directly is cheaper than more intersecting.
+        std::vector<int> candidates = *lists.front();
+        for (size_t l = 1; l < lists.size() && candidates.size() > kVerifyDirectly; l++) {
+            intersectInto(candidates, *lists[l]);
+        }
+
+        // Grams can match out of order, so verify every candidate
+        for (int id : candidates) {
+            if (needle.size() == 3 || TextScan::contains(m_texts.at(id), needle)) result.push_back(id);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Upper bound on the number of findContaining() hits
+     * Size of the shortest posting list among the fragment's grams (0 if a
+     * gram is missing); fragments without a gram may match everything.
+     */
+    size_t estimateContaining(const QString& fragment) const
+    {
+        std::vector<quint64> grams = gramsOf(fragment.toLower());
+        if (grams.empty()) return m_texts.size();
+        size_t best = m_texts.size();
+        for (quint64 gram : grams) {
+            auto posting = m_postings.find(gram);
+            if (posting == m_postings.end()) return 0;
+            best = std::min(best, posting->second.size());
+        }
+        return best;
+    }
+
+    /**
+     * @brief Find books whose whole text is within an edit distance of a query
+     *
+     * Candidate filter (q-gram lemma): one edit destroys at most 3 grams,
+     * so a text within distance k still shares all but 3k of the query's
+     * distinct grams and must appear in at least one of any 3k + 1 of its
+     * posting lists. The 3k + 1 shortest lists are merged and every
+     * candidate is verified with the bit-parallel edit distance. Queries
+     * too short for the filter to prune anything scan all stored texts.
+     *
+     * @param query Text to match (case-insensitive)
+     * @param maxDistance Largest accepted Levenshtein distance
+     * @return (book ID, distance) pairs in ascending ID order
+     */
+    std::vector<std::pair<int, int>> findSimilar(const QString& query, int maxDistance) const
+    {
+        QString needle = query.toLower();
+        Searching::EditDistanceMatcher<ushort> matcher(needle.utf16(), needle.size());
+        std::vector<std::pair<int, int>> result;
+        auto verify = [&](int id, const QString& text) {
+            int d = matcher.distance(text.utf16(), text.size(), maxDistance);
+            if (d <= maxDistance) result.emplace_back(id, d);
+        };
+
+        std::vector<quint64> grams = gramsOf(needle);
+        size_t mustShare = grams.size() > size_t(3) * maxDistance ? grams.size() - size_t(3) * maxDistance : 0;
+        if (mustShare == 0) {
+            for (const auto& entry : m_texts) verify(entry.first, entry.second);
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        // A gram missing from the index has an empty posting list: the best filter of all
+        static const std::vector<int> kNoIds;
+        std::vector<const std::vector<int>*> lists;
+        lists.reserve(grams.size());
+        for (quint64 gram : grams) {
+            auto posting = m_postings.find(gram);
+            lists.push_back(posting != m_postings.end() ? &posting->second : &kNoIds);
+        }
+        std::sort(lists.begin(), lists.end(),
+                  [](const std::vector<int>* a, const std::vector<int>* b) { return a->size() < b->size(); });
+
+        std::vector<int> candidates;
+        size_t pick = grams.size() - mustShare + 1;
+        for (size_t l = 0; l < pick; l++) {
+            candidates.insert(candidates.end(), lists[l]->begin(), lists[l]->end());
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        for (int id : candidates) verify(id, m_texts.at(id));
+        return result;
+    }
+
+    /**
+     * @brief Folded text stored for a book
+     * @return Pointer to the lowercased text, nullptr if the book is not indexed
+     */
+    const QString* textOf(int id) const
+    {
+        auto it = m_texts.find(id);
+        return it != m_texts.end() ? &it->second : nullptr;
+    }
+
+    size_t size() const { return m_texts.size(); }
+
+private:
+    static constexpr size_t kVerifyDirectly = 32;  ///< Stop intersecting below this many candidates
+    static constexpr size_t kGallopRatio = 16;     ///< Size ratio at which probing beats merging
+
+    std::unordered_map<quint64, std::vector<int>> m_postings;  ///< Gram -> sorted book IDs
+    std::unordered_map<int, QString> m_texts;                  ///< Book ID -> folded text
+    TextScan::PackedTexts m_packed;                            ///< Same texts, contiguous, for gram-less scans
+
+    /**
+     * @brief Keep only the candidates that also appear in a sorted posting list
+     * Linear merge for lists of similar size, binary-search probing when the
+     * posting list is much longer than the candidate set.
+     */
+    static void intersectInto(std::vector<int>& candidates, const std::vector<int>& other)
+    {
+        size_t kept = 0;
+        if (other.size() >= candidates.size() * kGallopRatio) {
+            auto from = other.begin();
+            for (int id : candidates) {
+                from = std::lower_bound(from, other.end(), id);
+                if (from == other.end()) break;
+                if (*from == id) candidates[kept++] = id;
+            }
+        } else {
+            size_t j = 0;
+            for (size_t i = 0; i < candidates.size() && j < other.size(); ) {
+                if (candidates[i] < other[j]) i++;
+                else if (other[j] < candidates[i]) j++;
+                else { candidates[kept++] = candidates[i]; i++; j++; }
+            }
+        }
+        candidates.resize(kept);
+    }
+
+    /**
+     * @brief Distinct grams of a folded text (3 UTF-16 units packed into 48 bits)
+     */
+    static std::vector<quint64> gramsOf(const QString& folded)
+    {
+        std::vector<quint64> grams;
+        if (folded.size() < 3) return grams;
+        grams.reserve(folded.size() - 2);
+        for (int i = 0; i + 3 <= folded.size(); i++) {
+            quint64 gram = (static_cast<quint64>(folded.at(i).unicode()) << 32)
+                         | (static_cast<quint64>(folded.at(i + 1).unicode()) << 16)
+                         | static_cast<quint64>(folded.at(i + 2).unicode());
+            grams.push_back(gram);
+        }
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+        return grams;
+    }
+};
+
+#endif // TRIGRAMINDEX_H
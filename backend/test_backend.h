@@ -5,25 +5,459 @@
 #include "Graph.h"
 #include "Sorting.h"
 #include "Searching.h"
+#include "SearchSession.h"
+#include "QueryEngine.h"
+#include "TextScan.h"
+#include "Sketches.h"
 #include <QDebug>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <set>
+#include <utility>
+
+/**
+ * @brief Check a condition; a failure is reported and counted, never aborts
+ * Unlike Q_ASSERT it also runs in release builds, so ctest sees every failure.
+ */
+#define TEST_CHECK(condition) TestBackend::check((condition), #condition, __FILE__, __LINE__)
 
 /**
  * @brief Simple test suite for backend classes
+ * Built as the backend_tests executable (see CMakeLists.txt) and run by ctest.
  */
 class TestBackend
 {
 public:
-    static void runAllTests()
+    /**
+     * @brief Run every test
+     * @return Number of failed checks (0 = all passed)
+     */
+    static int runAllTests()
     {
         qDebug() << "========== RUNNING BACKEND TESTS ==========\n";
+        failures() = 0;
         
         testBook();
         testBookManager();
         testGraph();
         testSorting();
         testSearching();
+        testSecondaryIndex();
+        testIdHashIndex();
+        testBalancedBST();
+        testTrigramIndex();
+        testPrefixTrie();
+        testSearchSession();
+        testFuzzySearch();
+        testRoaringBitmap();
+        testRangeIndex();
+        testQueryEngine();
+        testCatalogStats();
+        testSketches();
+        testBookStore();
+        
+        if (failures() == 0) {
+            qDebug() << "\n========== ALL TESTS PASSED ==========";
+        } else {
+            qWarning() << "\n==========" << failures() << "CHECKS FAILED ==========";
+        }
+        return failures();
+    }
+
+    /**
+     * @brief Run every benchmark on large synthetic catalogs (slow; not part of ctest)
+     */
+    static void runAllBenchmarks()
+    {
+        benchmarkSortKeys();
+        benchmarkIdLookup();
+        benchmarkBuildBST();
+        benchmarkFuzzySearch();
+        benchmarkBinarySearch();
+        benchmarkSubstringScan();
+        benchmarkColumnScan();
+    }
+
+    /**
+     * @brief Record the outcome of one check (use TEST_CHECK)
+     * @return The condition
+     */
+    static bool check(bool condition, const char* expression, const char* file, int line)
+    {
+        if (!condition) {
+            failures()++;
+            qWarning() << "  ✗ FAILED:" << expression << "at" << file << ":" << line;
+        }
+        return condition;
+    }
+
+    /**
+     * @brief Failed checks since the last runAllTests()
+     */
+    static int& failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    /**
+     * @brief Deterministic random source for synthetic test and benchmark data
+     * Linear congruential generator, so every platform and run sees the same
+     * data. Words are built from Indonesian-like syllables, which makes
+     * their trigrams as skewed as in real titles.
+     */
+    class SyntheticRandom
+    {
+    public:
+        explicit SyntheticRandom(quint32 seed = 12345) : m_seed(seed) {}
+        
+        quint32 next()
+        {
+            m_seed = m_seed * 1664525u + 1013904223u;
+            return m_seed >> 8;
+        }
+        
+        /// One word of 1-3 syllables
+        QString word()
+        {
+            static const char* const syllables[] = {"la", "ska", "r", "pe", "lan", "gi", "bu", "mi", "ma", "nu",
+                                                    "si", "ra", "ti", "ka", "ha", "ya", "an", "ke", "ba", "sa"};
+            const quint32 syllableCount = sizeof(syllables) / sizeof(syllables[0]);
+            QString w;
+            for (int s = 1 + next() % 3; s > 0; s--) w += syllables[next() % syllableCount];
+            return w;
+        }
+        
+        /// Several words separated by spaces
+        QString words(int count)
+        {
+            QString text = word();
+            for (int w = 1; w < count; w++) text += " " + word();
+            return text;
+        }
+        
+    private:
+        quint32 m_seed;
+    };
+    
+    /**
+     * @brief Synthetic catalog shared by the benchmarks
+     * IDs 1..count; three-word syllable titles, 50k distinct authors, two of
+     * eight genres, years 1950-2024 and ratings 0.0-5.0 in steps of 0.1.
+     * @param count Number of books
+     * @param seed Generator seed (same seed = same catalog)
+     */
+    static std::vector<Book> makeSyntheticCatalog(int count, quint32 seed = 12345)
+    {
+        static const char* const genres[] = {"Fiksi", "Sejarah", "Sains", "Biografi", "Horror", "Drama", "Komedi", "Puisi"};
+        SyntheticRandom random(seed);
+        std::vector<Book> books;
+        books.reserve(count);
+        for (int i = 1; i <= count; i++) {
+            QString title = random.words(3);
+            QString author = QString("Penulis %1").arg(random.next() % 50000);
+            QStringList bookGenres{genres[random.next() % 8], genres[random.next() % 8]};
+            int year = 1950 + random.next() % 75;
+            double rating = (random.next() % 51) / 10.0;
+            books.push_back(Book(i, title, author, bookGenres, year, rating));
+        }
+        return books;
+    }
+
+    /**
+     * @brief Benchmark title/author sorts: per-comparison toLower() vs precomputed folded keys
+     * Counts QString::toLower() calls; each returns a new string, so the
+     * count is also the number of temporary string allocations per sort.
+     * @param bookCount Number of generated books
+     */
+    static void benchmarkSortKeys(int bookCount = 100000)
+    {
+        qDebug() << "BENCHMARK: title/author sort with" << bookCount << "books";
+        
+        const std::vector<Book> catalog = makeSyntheticCatalog(bookCount);
+        for (bool byTitle : {true, false}) {
+            auto text = [byTitle](const Book& book) { return byTitle ? book.getJudul() : book.getPenulis(); };
+            
+            // Old path: both strings lowercased inside every comparison
+            std::vector<Book> oldOrder = catalog;
+            long long oldCalls = 0;
+            QElapsedTimer timer;
+            timer.start();
+            Sorting::quickSort(oldOrder, [&](const Book& a, const Book& b) {
+                oldCalls += 2;
+                int cmp = QString::compare(text(a).toLower(), text(b).toLower());
+                return cmp != 0 ? cmp < 0 : a.getId() < b.getId();
+            });
+            double oldMs = timer.nsecsElapsed() / 1000000.0;
+            
+            // New path: one folded (text, id) key per book
+            std::vector<Book> newOrder = catalog;
+            long long newCalls = 0;
+            timer.restart();
+            Sorting::sortByKey(newOrder,
+                [&](const Book& book) { newCalls++; return std::make_pair(text(book).toLower(), book.getId()); },
+                [](const std::pair<QString, int>& a, const std::pair<QString, int>& b) {
+                    int cmp = QString::compare(a.first, b.first);
+                    return cmp != 0 ? cmp < 0 : a.second < b.second;
+                });
+            double newMs = timer.nsecsElapsed() / 1000000.0;
+            
+            bool sameOrder = true;
+            for (size_t i = 0; sameOrder && i < oldOrder.size(); i++) sameOrder = oldOrder[i].getId() == newOrder[i].getId();
+            TEST_CHECK(sameOrder);
+            qDebug() << "  " << (byTitle ? "title: " : "author:") << "comparator" << oldCalls << "toLower calls,"
+                     << oldMs << "ms; folded keys" << newCalls << "toLower calls," << newMs << "ms";
+        }
+    }
+
+    /**
+     * @brief Benchmark getBookById (IdHashIndex) against a linear scan over the books
+     * Runs at 10k, 100k and 1M books. Each catalog is sorted by title first,
+     * so IDs no longer match their slots.
+     * @param lookups Number of lookups per variant and size
+     */
+    static void benchmarkIdLookup(int lookups = 2000)
+    {
+        for (int bookCount : {10000, 100000, 1000000}) {
+            qDebug() << "BENCHMARK: getBookById with" << bookCount << "books," << lookups << "lookups";
+            
+            BookManager manager;
+            manager.setBooks(makeSyntheticCatalog(bookCount));
+            manager.quickSortByTitle();
+            const std::vector<Book> books = manager.getAllBooks();
+            
+            SyntheticRandom random(54321);
+            std::vector<int> ids;
+            ids.reserve(lookups);
+            for (int i = 0; i < lookups; i++) ids.push_back(1 + random.next() % bookCount);
+            
+            QElapsedTimer timer;
+            timer.start();
+            long long hashChecksum = 0;
+            for (int id : ids) {
+                const Book* book = manager.getBookById(id);
+                if (book) hashChecksum += book->getTahun();
+            }
+            double hashNs = static_cast<double>(timer.nsecsElapsed()) / lookups;
+            
+            timer.restart();
+            long long scanChecksum = 0;
+            for (int id : ids) {
+                for (const Book& book : books) {
+                    if (book.getId() == id) {
+                        scanChecksum += book.getTahun();
+                        break;
+                    }
+                }
+            }
+            double scanNs = static_cast<double>(timer.nsecsElapsed()) / lookups;
+            
+            TEST_CHECK(hashChecksum == scanChecksum);
+            qDebug() << "   hash index:" << hashNs << "ns/lookup, linear scan:" << scanNs << "ns/lookup ("
+                     << scanNs / std::max(hashNs, 1e-3) << "x )";
+        }
+    }
+
+    /**
+     * @brief Benchmark building the title BST: AVL inserts vs bulk load from the title index
+     * Both trees must hold the same books in the same order.
+     * @param bookCount Number of generated books
+     */
+    static void benchmarkBuildBST(int bookCount = 500000)
+    {
+        qDebug() << "BENCHMARK: title BST build with" << bookCount << "books";
+        
+        BookManager manager;
+        manager.setBooks(makeSyntheticCatalog(bookCount));
+        const std::vector<Book>& books = manager.books();
+        
+        // Old path: one toLower() and one O(log n) insert (with rotations) per book
+        QElapsedTimer timer;
+        timer.start();
+        BalancedBST incremental;
+        incremental.reserve(books.size());
+        for (const Book& book : books) incremental.insert(book.getJudul().toLower(), book);
+        double insertMs = timer.nsecsElapsed() / 1000000.0;
+        
+        // New path: linear bulk load from the sorted title index
+        timer.restart();
+        manager.buildBST();
+        double bulkMs = timer.nsecsElapsed() / 1000000.0;
+        
+        std::vector<int> incrementalIds;
+        incremental.inOrder([&](const QString&, const Book& book) { incrementalIds.push_back(book.getId()); });
+        std::vector<int> bulkIds;
+        for (const Book& book : manager.getBSTInOrder()) bulkIds.push_back(book.getId());
+        TEST_CHECK(incrementalIds == bulkIds);
+        qDebug() << "   AVL inserts:" << insertMs << "ms (height" << incremental.height() << "), bulk load:"
+                 << bulkMs << "ms (" << insertMs / std::max(bulkMs, 1e-3) << "x ),"
+                 << bulkIds.size() << "distinct titles";
+    }
+
+    /**
+     * @brief Benchmark fuzzy title search on a large synthetic catalog
+     * @param bookCount Number of generated books
+     */
+    static void benchmarkFuzzySearch(int bookCount = 1000000)
+    {
+        qDebug() << "BENCHMARK: fuzzySearchByTitle with" << bookCount << "books";
+        
+        std::vector<Book> books = makeSyntheticCatalog(bookCount);
+        books[bookCount / 2].setJudul("Laskar Pelangi");
+        
+        BookManager manager;
+        manager.setBooks(books);
+        
+        for (const char* query : {"Laskar Pelngi", "Lasker Pelangii", "Bumi Manusia"}) {
+            for (int maxDistance = 1; maxDistance <= 3; maxDistance++) {
+                QElapsedTimer timer;
+                timer.start();
+                std::vector<Book> results = manager.fuzzySearchByTitle(query, maxDistance);
+                qDebug() << "  " << query << "k =" << maxDistance << ":" << results.size()
+                         << "hits in" << timer.nsecsElapsed() / 1000000.0 << "ms";
+            }
+        }
+    }
+
+    /**
+     * @brief Benchmark binary search: std::function key extractor vs template comparator
+     * @param bookCount Number of generated books
+     * @param lookups Number of searches per variant
+     */
+    static void benchmarkBinarySearch(int bookCount = 1000000, int lookups = 200000)
+    {
+        qDebug() << "BENCHMARK: binary search with" << bookCount << "books," << lookups << "lookups";
+        
+        std::vector<Book> books;
+        books.reserve(bookCount);
+        for (int i = 1; i <= bookCount; i++) {
+            books.push_back(Book(i, QString("Judul %1").arg(i, 8, 10, QChar('0')), "Author",
+                                 QStringList{"Genre"}, 2000, 4.0));
+        }
+        SyntheticRandom random;
+        BookManager manager;
+        manager.setBooks(books);  // Titles are already sorted (zero-padded numbers)
+        
+        std::vector<QString> keys;
+        std::vector<int> ids;
+        for (int i = 0; i < lookups; i++) {
+            int id = 1 + random.next() % bookCount;
+            keys.push_back(books[id - 1].getJudul().toLower());
+            ids.push_back(id);
+        }
+        
+        // Old version: std::function + toLower() (a new QString) on every probe
+        QElapsedTimer timer;
+        timer.start();
+        long long found = 0;
+        std::function<QString(const Book&)> getKey = [](const Book& book) { return book.getJudul().toLower(); };
+        for (const QString& key : keys) found += Searching::binarySearchByKey(books, key, getKey) >= 0;
+        qDebug() << "  binarySearchByKey (std::function):" << timer.nsecsElapsed() / 1000000.0 << "ms," << found << "found";
         
-        qDebug() << "\n========== ALL TESTS COMPLETE ==========";
+        timer.restart();
+        found = 0;
+        for (const QString& key : keys) found += manager.binarySearchByTitle(key) != nullptr;
+        qDebug() << "  binarySearchByTitle (binarySearchBy, in place):" << timer.nsecsElapsed() / 1000000.0 << "ms," << found << "found";
+        
+        // Cheap integer keys: branchy vs branchless
+        std::vector<int> sortedIds(bookCount);
+        for (int i = 0; i < bookCount; i++) sortedIds[i] = i + 1;
+        timer.restart();
+        long long sum = 0;
+        for (int id : ids) sum += *Searching::lowerBound(sortedIds.begin(), sortedIds.end(), id);
+        qDebug() << "  lowerBound (int):" << timer.nsecsElapsed() / 1000000.0 << "ms, checksum" << sum;
+        
+        timer.restart();
+        sum = 0;
+        for (int id : ids) sum += *Searching::branchlessLowerBound(sortedIds.begin(), sortedIds.end(), id);
+        qDebug() << "  branchlessLowerBound (int):" << timer.nsecsElapsed() / 1000000.0 << "ms, checksum" << sum;
+    }
+
+    /**
+     * @brief Benchmark the packed substring scan per kernel (GB/s) against toLower().contains()
+     * @param bookCount Number of generated titles
+     */
+    static void benchmarkSubstringScan(int bookCount = 1000000)
+    {
+        qDebug() << "BENCHMARK: substring scan over" << bookCount << "titles, CPU supports"
+                 << TextScan::levelName(TextScan::supportedLevel());
+        
+        SyntheticRandom random;
+        std::vector<QString> titles;
+        TextScan::PackedTexts packed;
+        titles.reserve(bookCount);
+        for (int i = 0; i < bookCount; i++) {
+            QString title = random.words(3) + " Dan " + random.words(3);
+            titles.push_back(title);
+            packed.insert(i, title.toLower());
+        }
+        
+        for (const char* query : {"q", "Zx", "laskar"}) {
+            QString needle = QString(query).toLower();
+            
+            QElapsedTimer timer;
+            timer.start();
+            size_t naive = 0;
+            for (const QString& title : titles) naive += title.toLower().contains(needle);
+            qDebug() << "  " << query << "toLower().contains():" << timer.nsecsElapsed() / 1000000.0 << "ms," << naive << "hits";
+            
+            for (TextScan::Level level : {TextScan::Level::Scalar, TextScan::Level::SSE2, TextScan::Level::AVX2}) {
+                if (static_cast<int>(level) > static_cast<int>(TextScan::supportedLevel())) continue;
+                TextScan::setLevel(level);
+                timer.restart();
+                size_t hits = packed.findContaining(needle).size();
+                double seconds = timer.nsecsElapsed() / 1e9;
+                qDebug() << "  " << query << TextScan::levelName(level) << ":" << seconds * 1000 << "ms,"
+                         << packed.bytes() / seconds / 1e9 << "GB/s," << hits << "hits";
+            }
+        }
+        TextScan::setLevel(TextScan::supportedLevel());
+    }
+
+    /**
+     * @brief Benchmark a year + rating + genre filter: Book rows vs the BookStore columns
+     * @param bookCount Number of generated books
+     */
+    static void benchmarkColumnScan(int bookCount = 1000000)
+    {
+        qDebug() << "BENCHMARK: year/rating/genre scan over" << bookCount << "books";
+        
+        BookManager manager;
+        manager.setBooks(makeSyntheticCatalog(bookCount));
+        const std::vector<Book>& rows = manager.books();
+        const BookStore& store = manager.getBookStore();
+        
+        for (int round = 0; round < 3; round++) {
+            QElapsedTimer timer;
+            timer.start();
+            size_t rowHits = 0;
+            for (const Book& book : rows) {
+                if (book.getTahun() < 1990 || book.getTahun() > 2010 || book.getRating() < 4.0) continue;
+                for (const QString& genre : book.getGenre()) {
+                    if (genre.compare("Sains", Qt::CaseInsensitive) == 0) { rowHits++; break; }
+                }
+            }
+            double rowMs = timer.nsecsElapsed() / 1000000.0;
+            
+            timer.restart();
+            size_t columnHits = 0;
+            const qint32* years = store.years().data();
+            const qint32* ratings = store.ratings().data();
+            const uint64_t* masks = store.genreMasks().data();
+            uint64_t sains = store.genreBit("Sains");
+            for (size_t slot = 0; slot < store.size(); slot++) {
+                columnHits += (years[slot] >= 1990) & (years[slot] <= 2010) & (ratings[slot] >= 400)
+                            & ((masks[slot] & sains) != 0);
+            }
+            double columnMs = timer.nsecsElapsed() / 1000000.0;
+            
+            TEST_CHECK(rowHits == columnHits);
+            qDebug() << "  rows:" << rowMs << "ms, columns:" << columnMs << "ms (" << rowMs / columnMs << "x ),"
+                     << columnHits << "hits," << store.columnBytes() / (1024 * 1024) << "MB of columns";
+        }
     }
 
 private:
@@ -34,10 +468,10 @@ class TestBackend
         Book book(1, "Test Book", "Test Author", 
                   QStringList{"Genre1", "Genre2"}, 2024, 4.5);
         
-        Q_ASSERT(book.getId() == 1);
-        Q_ASSERT(book.getJudul() == "Test Book");
-        Q_ASSERT(book.hasGenre("Genre1"));
-        Q_ASSERT(!book.hasGenre("Genre3"));
+        TEST_CHECK(book.getId() == 1);
+        TEST_CHECK(book.getJudul() == "Test Book");
+        TEST_CHECK(book.hasGenre("Genre1"));
+        TEST_CHECK(!book.hasGenre("Genre3"));
         
         qDebug() << "  ✓ Book creation and getters work";
         qDebug() << "  ✓ hasGenre() works";
@@ -45,8 +479,8 @@ class TestBackend
         // Test JSON conversion
         QJsonObject json = book.toJson();
         Book book2 = Book::fromJson(json);
-        Q_ASSERT(book2.getId() == book.getId());
-        Q_ASSERT(book2.getJudul() == book.getJudul());
+        TEST_CHECK(book2.getId() == book.getId());
+        TEST_CHECK(book2.getJudul() == book.getJudul());
         
         qDebug() << "  ✓ JSON serialization works\n";
     }
@@ -64,38 +498,47 @@ class TestBackend
             manager.addBook(book);
         }
         
-        Q_ASSERT(manager.getBookCount() == 5);
+        TEST_CHECK(manager.getBookCount() == 5);
         qDebug() << "  ✓ addBook() works";
         
         // Get book by ID
         Book* book = manager.getBookById(3);
-        Q_ASSERT(book != nullptr);
-        Q_ASSERT(book->getId() == 3);
+        TEST_CHECK(book != nullptr);
+        TEST_CHECK(book->getId() == 3);
         qDebug() << "  ✓ getBookById() works";
         
         // Sort by year
         manager.quickSortByYear(true);
         std::vector<Book> books = manager.getAllBooks();
-        Q_ASSERT(books[0].getTahun() <= books[1].getTahun());
+        TEST_CHECK(books[0].getTahun() <= books[1].getTahun());
         qDebug() << "  ✓ quickSortByYear() works";
         
         // Sort by title
         manager.quickSortByTitle(true);
         books = manager.getAllBooks();
-        Q_ASSERT(books[0].getJudul() <= books[1].getJudul());
+        TEST_CHECK(books[0].getJudul() <= books[1].getJudul());
         qDebug() << "  ✓ quickSortByTitle() works";
         
         // Binary search (on sorted data)
         Book* found = manager.binarySearchByTitle("Book 3");
-        Q_ASSERT(found != nullptr);
-        Q_ASSERT(found->getJudul() == "Book 3");
+        TEST_CHECK(found != nullptr);
+        TEST_CHECK(found->getJudul() == "Book 3");
         qDebug() << "  ✓ binarySearchByTitle() works";
         
+        // Snapshots are shared per version; reorders keep the version, content changes bump it
+        BookManager::Snapshot snapshot = manager.getSnapshot();
+        quint64 version = manager.getVersion();
+        TEST_CHECK(manager.getSnapshot() == snapshot);
+        manager.quickSortByRating(false);
+        TEST_CHECK(manager.getVersion() == version && manager.getSnapshot() == snapshot);
+        
         // Remove book
         bool removed = manager.removeBook(3);
-        Q_ASSERT(removed == true);
-        Q_ASSERT(manager.getBookCount() == 4);
-        qDebug() << "  ✓ removeBook() works\n";
+        TEST_CHECK(removed == true);
+        TEST_CHECK(manager.getBookCount() == 4);
+        TEST_CHECK(manager.getVersion() > version && manager.getSnapshot() != snapshot);
+        TEST_CHECK(snapshot->size() == 5);
+        qDebug() << "  ✓ removeBook() works, snapshot/version track content changes\n";
     }
 
     static void testGraph()
@@ -108,11 +551,11 @@ class TestBackend
         graph.addEdge("GenreA", "GenreB");
         graph.addEdge("GenreB", "GenreC");
         
-        Q_ASSERT(graph.hasEdge("GenreA", "GenreB"));
-        Q_ASSERT(graph.hasEdge("GenreB", "GenreA")); // Undirected
+        TEST_CHECK(graph.hasEdge("GenreA", "GenreB"));
+        TEST_CHECK(graph.hasEdge("GenreB", "GenreA")); // Undirected
         qDebug() << "  ✓ addEdge() and hasEdge() work";
         
-        Q_ASSERT(graph.getGenreDegree("GenreB") == 2);
+        TEST_CHECK(graph.getGenreDegree("GenreB") == 2);
         qDebug() << "  ✓ getGenreDegree() works";
         
         // Test with books
@@ -125,22 +568,22 @@ class TestBackend
         Graph bookGraph;
         bookGraph.buildGraph(manager.getAllBooks());
         
-        Q_ASSERT(bookGraph.hasEdge("A", "B"));
-        Q_ASSERT(bookGraph.hasEdge("B", "C"));
+        TEST_CHECK(bookGraph.hasEdge("A", "B"));
+        TEST_CHECK(bookGraph.hasEdge("B", "C"));
         qDebug() << "  ✓ buildGraph() works";
         
         // Test recommendations
         std::vector<Book> recs = bookGraph.getRecommendation("A", 
                                                              manager.getAllBooks(), 
                                                              2);
-        Q_ASSERT(recs.size() > 0);
+        TEST_CHECK(recs.size() > 0);
         qDebug() << "  ✓ getRecommendation() works";
         
         // Test path finding
         std::vector<QString> path = bookGraph.findPath("A", "C");
-        Q_ASSERT(!path.empty());
-        Q_ASSERT(path[0] == "A");
-        Q_ASSERT(path[path.size()-1] == "C");
+        TEST_CHECK(!path.empty());
+        TEST_CHECK(path[0] == "A");
+        TEST_CHECK(path[path.size()-1] == "C");
         qDebug() << "  ✓ findPath() works\n";
     }
 
@@ -154,17 +597,178 @@ class TestBackend
         std::vector<int> arr1 = arr;
         Sorting::quickSort(arr1, 0, arr1.size() - 1,
                           [](int a, int b) { return a < b; });
-        Q_ASSERT(arr1[0] == 1);
-        Q_ASSERT(arr1[arr1.size()-1] == 9);
+        TEST_CHECK(arr1[0] == 1);
+        TEST_CHECK(arr1[arr1.size()-1] == 9);
         qDebug() << "  ✓ QuickSort works";
         
+        // Introsort: sorted, reversed, all-equal, organ-pipe and random input must sort like std::sort
+        SyntheticRandom random;
+        std::vector<std::vector<int>> inputs(5);
+        for (int i = 0; i < 5000; i++) {
+            inputs[0].push_back(i);
+            inputs[1].push_back(5000 - i);
+            inputs[2].push_back(7);
+            inputs[3].push_back(i < 2500 ? i : 5000 - i);
+            inputs[4].push_back(static_cast<int>(random.next() % 100));
+        }
+        bool allSorted = true;
+        for (std::vector<int>& input : inputs) {
+            std::vector<int> expected = input;
+            std::sort(expected.begin(), expected.end());
+            Sorting::quickSort(input);
+            allSorted = allSorted && input == expected;
+        }
+        TEST_CHECK(allSorted);
+        qDebug() << "  ✓ QuickSort handles adversarial input";
+        
         // Test MergeSort
         std::vector<int> arr2 = arr;
-        Sorting::mergeSort(arr2, 0, arr2.size() - 1,
-                          [](int a, int b) { return a < b; });
-        Q_ASSERT(arr2[0] == 1);
-        Q_ASSERT(arr2[arr2.size()-1] == 9);
-        qDebug() << "  ✓ MergeSort works\n";
+        Sorting::mergeSort(arr2, [](int a, int b) { return a < b; });
+        TEST_CHECK(arr2[0] == 1);
+        TEST_CHECK(arr2[arr2.size()-1] == 9);
+        qDebug() << "  ✓ MergeSort works";
+        
+        // Parallel MergeSort is stable and independent of the worker count
+        std::vector<std::pair<int, int>> pairs;
+        for (int i = 0; i < 100000; i++) pairs.emplace_back(static_cast<int>(random.next() % 50), i);
+        std::vector<std::pair<int, int>> expectedPairs = pairs;
+        auto byFirst = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+        std::stable_sort(expectedPairs.begin(), expectedPairs.end(), byFirst);
+        Sorting::parallelMergeSort(pairs, byFirst, 4);
+        TEST_CHECK(pairs == expectedPairs);
+        
+        BookManager serial, parallel;
+        for (int i = 1; i <= 3000; i++) {
+            Book book(i, QString("Judul %1").arg(random.next() % 200), "Penulis", QStringList{"Fiksi"},
+                      1950 + random.next() % 75, (random.next() % 51) / 10.0);
+            serial.addBook(book);
+            parallel.addBook(book);
+        }
+        serial.setSortWorkerCount(1);
+        parallel.setSortWorkerCount(4);
+        parallel.setParallelSortThreshold(1);
+        serial.quickSortByTitle(true);
+        parallel.quickSortByTitle(true);
+        std::vector<Book> serialBooks = serial.getAllBooks();
+        std::vector<Book> parallelBooks = parallel.getAllBooks();
+        bool sameOrder = serialBooks.size() == parallelBooks.size();
+        for (size_t i = 0; sameOrder && i < serialBooks.size(); i++) {
+            sameOrder = serialBooks[i].getId() == parallelBooks[i].getId();
+        }
+        TEST_CHECK(sameOrder);
+        qDebug() << "  ✓ Parallel MergeSort is stable and matches the serial sort";
+        
+        // Sort by precomputed key: stable, key extractor called once per element
+        std::vector<std::pair<QString, int>> words = {{"b", 1}, {"A", 2}, {"a", 3}, {"C", 4}, {"B", 5}};
+        int keyCalls = 0;
+        Sorting::sortByKey(words, [&keyCalls](const std::pair<QString, int>& w) { keyCalls++; return w.first.toLower(); },
+                           [](const QString& a, const QString& b) { return a < b; });
+        TEST_CHECK(keyCalls == 5);
+        TEST_CHECK(words[0].second == 2 && words[1].second == 3 && words[2].second == 1 && words[3].second == 5);
+        
+        BookManager titles;
+        titles.addBook(Book(1, "bumi", "x", QStringList{"Fiksi"}, 2000, 4.0));
+        titles.addBook(Book(2, "Bumi", "x", QStringList{"Fiksi"}, 2000, 4.0));
+        titles.addBook(Book(3, "Anak", "x", QStringList{"Fiksi"}, 2000, 4.0));
+        titles.quickSortByTitle(false);
+        std::vector<Book> sortedTitles = titles.getAllBooks();
+        // Descending is the exact reverse of ascending, so equal titles fall back to ID descending
+        TEST_CHECK(sortedTitles[0].getId() == 2 && sortedTitles[1].getId() == 1 && sortedTitles[2].getId() == 3);
+        qDebug() << "  ✓ sortByKey and folded title sort work";
+        
+        // Radix sort on integer keys (negative values included) is stable in both directions
+        for (Sorting::SortOrder order : {Sorting::SortOrder::Ascending, Sorting::SortOrder::Descending}) {
+            std::vector<Sorting::KeyedIndex<int>> keys;
+            for (uint32_t i = 0; i < 20000; i++) keys.push_back({static_cast<int>(random.next() % 4000) - 2000, i});
+            std::vector<Sorting::KeyedIndex<int>> expected = keys;
+            bool ascendingOrder = order == Sorting::SortOrder::Ascending;
+            std::stable_sort(expected.begin(), expected.end(),
+                             [ascendingOrder](const Sorting::KeyedIndex<int>& a, const Sorting::KeyedIndex<int>& b) {
+                                 return ascendingOrder ? a.key < b.key : a.key > b.key;
+                             });
+            Sorting::radixSort(keys, order);
+            bool same = true;
+            for (size_t i = 0; same && i < keys.size(); i++) same = keys[i].index == expected[i].index;
+            TEST_CHECK(same);
+        }
+        qDebug() << "  ✓ radixSort works";
+        
+        // Sorted index permutations give the same order as sorting the books
+        BookManager catalog;
+        for (const Book& book : makeSyntheticCatalog(2000)) catalog.addBook(book);
+        bool indicesMatch = true;
+        for (BookManager::SortField field : {BookManager::SortField::Title, BookManager::SortField::Author,
+                                             BookManager::SortField::Year, BookManager::SortField::Rating}) {
+            for (bool ascending : {true, false}) {
+                std::vector<uint32_t> indices = catalog.getSortedIndices(field, ascending);
+                BookManager sorted = catalog;
+                switch (field) {
+                    case BookManager::SortField::Title: sorted.quickSortByTitle(ascending); break;
+                    case BookManager::SortField::Author: sorted.quickSortByAuthor(ascending); break;
+                    case BookManager::SortField::Year: sorted.quickSortByYear(ascending); break;
+                    case BookManager::SortField::Rating: sorted.quickSortByRating(ascending); break;
+                }
+                std::vector<Book> books = catalog.getAllBooks();
+                std::vector<Book> expected = sorted.getAllBooks();
+                indicesMatch = indicesMatch && indices.size() == expected.size();
+                for (size_t i = 0; indicesMatch && i < indices.size(); i++) {
+                    indicesMatch = books[indices[i]].getId() == expected[i].getId();
+                }
+            }
+        }
+        TEST_CHECK(indicesMatch);
+        qDebug() << "  ✓ sortIndices() matches quickSortBy*";
+        
+        // Bounded top-k (heap selection, the remaining elements are dropped)
+        std::vector<int> arr3 = arr;
+        Sorting::topK(arr3, 3, [](int a, int b) { return a > b; });
+        TEST_CHECK(arr3.size() == 3);
+        TEST_CHECK(arr3[0] == 9 && arr3[1] == 8 && arr3[2] == 5);
+        
+        // topKIndices keeps the first k positions of sortIndices, in the same order
+        const std::vector<Book>& catalogBooks = catalog.books();
+        bool topMatches = true;
+        for (BookManager::SortField field : {BookManager::SortField::Title, BookManager::SortField::Author,
+                                             BookManager::SortField::Year, BookManager::SortField::Rating}) {
+            for (bool ascending : {true, false}) {
+                std::vector<uint32_t> all = catalog.getSortedIndices(field, ascending);
+                std::vector<uint32_t> top(all.size());
+                std::iota(top.begin(), top.end(), 0u);
+                catalog.topKIndices(catalogBooks, top, 25, field, ascending);
+                topMatches = topMatches && std::equal(top.begin(), top.end(), all.begin(), all.begin() + 25);
+            }
+        }
+        TEST_CHECK(topMatches);
+        
+        std::vector<std::pair<double, int>> byRating;
+        for (const Book& book : catalogBooks) byRating.emplace_back(-book.getRating(), book.getId());
+        std::sort(byRating.begin(), byRating.end());
+        std::vector<Book> topRated = catalog.getTopRatedBooks(10);
+        bool topRatedMatches = topRated.size() == 10;
+        for (size_t i = 0; topRatedMatches && i < topRated.size(); i++) topRatedMatches = topRated[i].getId() == byRating[i].second;
+        TEST_CHECK(topRatedMatches);
+        qDebug() << "  ✓ topK/topKIndices/getTopRatedBooks work\n";
+    }
+
+    static void testSketches()
+    {
+        qDebug() << "TEST: Statistics sketches";
+        
+        // HyperLogLog: 100k distinct values, relative error must stay within ~4 standard errors
+        HyperLogLog hll;
+        for (int i = 0; i < 100000; i++) hll.add(QString("author-%1").arg(i));
+        for (int i = 0; i < 100000; i++) hll.add(QString("author-%1").arg(i));  // Duplicates are not counted
+        TEST_CHECK(std::abs(hll.estimate() - 100000.0) < 100000.0 * 4 * hll.standardError());
+        qDebug() << "  ✓ HyperLogLog estimate:" << hll.estimate();
+        
+        // Count-min: never below the true count, and removals undo additions
+        CountMinSketch cms;
+        for (int i = 0; i < 5000; i++) cms.add(QString("genre-%1").arg(i % 50));
+        TEST_CHECK(cms.estimate("genre-7") >= 100);
+        TEST_CHECK(cms.estimate("genre-7") <= 100 + cms.errorBound());
+        for (int i = 0; i < 100; i++) cms.add("genre-7", -1);
+        TEST_CHECK(cms.estimate("genre-7") <= cms.errorBound());
+        qDebug() << "  ✓ Count-min sketch works\n";
     }
 
     static void testSearching()
@@ -174,21 +778,746 @@ class TestBackend
         std::vector<int> sortedArr = {1, 3, 5, 7, 9, 11, 13};
         
         // Test Binary Search
-        int idx = Searching::binarySearch(sortedArr, 7,
+        int idx = Searching::binarySearch<int>(sortedArr, 7,
                                          [](int a, int b) { return a < b; });
-        Q_ASSERT(idx == 3);
+        TEST_CHECK(idx == 3);
         qDebug() << "  ✓ Binary Search works";
         
+        // Template lower/upper bound + equal_range (inline comparator, no std::function)
+        std::vector<int> dupArr = {1, 3, 3, 3, 5, 7};
+        auto range = Searching::equalRange(dupArr.begin(), dupArr.end(), 3);
+        TEST_CHECK(range.first - dupArr.begin() == 1 && range.second - dupArr.begin() == 4);
+        TEST_CHECK(Searching::branchlessLowerBound(dupArr.begin(), dupArr.end(), 4) == Searching::upperBound(dupArr.begin(), dupArr.end(), 3));
+        idx = Searching::binarySearchBy(sortedArr, 11, [](int element, int key) { return element - key; });
+        TEST_CHECK(idx == 5);
+        qDebug() << "  ✓ lowerBound/upperBound/equalRange work";
+        
         // Test Linear Search
         std::vector<int> unsortedArr = {5, 2, 8, 1, 9};
         idx = Searching::linearSearch(unsortedArr, 8);
-        Q_ASSERT(idx == 2);
-        qDebug() << "  ✓ Linear Search works";
+        TEST_CHECK(idx == 2);
+        qDebug() << "  ✓ Linear Search works\n";
+    }
+    /**
+     * @brief Random removes, updates and adds on a catalog (IDs stay within 1..2 x books)
+     */
+    static void mutateCatalog(BookManager& manager, int operations, quint32 seed)
+    {
+        SyntheticRandom random(seed);
+        int idRange = static_cast<int>(manager.getBookCount()) * 2 + 1;
+        for (int i = 0; i < operations; i++) {
+            int id = 1 + static_cast<int>(random.next() % idRange);
+            Book* book = manager.getBookById(id);
+            switch (random.next() % 3) {
+                case 0:
+                    manager.removeBook(id);
+                    break;
+                case 1:
+                    if (book) {
+                        Book changed = *book;
+                        changed.setJudul(random.words(2));
+                        changed.setTahun(1950 + random.next() % 75);
+                        changed.setRating((random.next() % 51) / 10.0);
+                        manager.updateBook(changed);
+                    }
+                    break;
+                default:
+                    if (!book) {
+                        manager.addBook(Book(id, random.words(3), QString("Penulis %1").arg(random.next() % 100),
+                                             QStringList{"Fiksi", "Puisi"}, 1950 + random.next() % 75,
+                                             (random.next() % 51) / 10.0));
+                    }
+                    break;
+            }
+        }
+    }
+
+    /// Book IDs of a manager in sortIndices() order
+    static std::vector<int> idsInSortOrder(const BookManager& manager, BookManager::SortField field, bool ascending)
+    {
+        std::vector<Book> books = manager.getAllBooks();
+        std::vector<uint32_t> slots(books.size());
+        std::iota(slots.begin(), slots.end(), 0u);
+        manager.sortIndices(books, slots, field, ascending);
+        std::vector<int> ids;
+        for (uint32_t slot : slots) ids.push_back(books[slot].getId());
+        return ids;
+    }
+
+    static void testSecondaryIndex()
+    {
+        qDebug() << "TEST: SecondaryIndex";
+        
+        SecondaryIndex index;
+        index.insert(SecondaryIndex::Entry("laskar pelangi", 0, 3));
+        index.insert(SecondaryIndex::Entry("bumi manusia", 0, 2));
+        index.insert(SecondaryIndex::Entry("laskar pelangi", 0, 1));  // Equal keys: ordered by ID
+        index.insert(SecondaryIndex::Entry("", 2005, 4));
+        std::vector<int> ascending, descending;
+        index.forEachId(true, [&](int id) { ascending.push_back(id); return true; });
+        index.forEachId(false, [&](int id) { descending.push_back(id); return true; });
+        TEST_CHECK((ascending == std::vector<int>{4, 2, 1, 3}));
+        TEST_CHECK((descending == std::vector<int>{3, 1, 2, 4}));
+        TEST_CHECK(index.lowerBound(SecondaryIndex::Entry("c", 0, 0))->id == 1);
+        TEST_CHECK(index.erase(SecondaryIndex::Entry("laskar pelangi", 0, 1)));
+        TEST_CHECK(!index.erase(SecondaryIndex::Entry("laskar pelangi", 0, 1)));
+        TEST_CHECK(index.size() == 3);
+        qDebug() << "  ✓ insert/erase/forEachId work";
+        
+        // BookManager's indexes must always be in sortIndices() order
+        BookManager manager;
+        manager.setBooks(makeSyntheticCatalog(3000));
+        mutateCatalog(manager, 1500, 77);
+        for (BookManager::SortField field : {BookManager::SortField::Title, BookManager::SortField::Author,
+                                             BookManager::SortField::Year, BookManager::SortField::Rating}) {
+            for (bool ascendingOrder : {true, false}) {
+                std::vector<int> walked;
+                manager.getSecondaryIndex(field).forEachId(ascendingOrder, [&](int id) { walked.push_back(id); return true; });
+                TEST_CHECK(walked == idsInSortOrder(manager, field, ascendingOrder));
+            }
+        }
+        qDebug() << "  ✓ BookManager secondary indexes follow sortIndices() after updates\n";
+    }
+
+    static void testIdHashIndex()
+    {
+        qDebug() << "TEST: IdHashIndex";
+        
+        IdHashIndex index;
+        TEST_CHECK(index.empty() && index.find(42) == IdHashIndex::kNotFound);
+        TEST_CHECK(!index.erase(42));
+        
+        // Compare against std::map; zero and negative IDs are valid keys too
+        std::map<int, uint32_t> reference;
+        SyntheticRandom random(99);
+        bool erasesMatch = true;
+        for (int i = 0; i < 20000; i++) {
+            int id = static_cast<int>(random.next() % 5000) - 1000;
+            if (random.next() % 4 == 0) {
+                erasesMatch = erasesMatch && index.erase(id) == (reference.erase(id) > 0);
+            } else {
+                uint32_t slot = random.next();
+                index.set(id, slot);
+                reference[id] = slot;
+            }
+        }
+        TEST_CHECK(erasesMatch);
+        TEST_CHECK(index.size() == reference.size());
+        bool lookupsMatch = true;
+        for (int id = -1000; id < 4000; id++) {
+            auto it = reference.find(id);
+            lookupsMatch = lookupsMatch && index.find(id) == (it != reference.end() ? it->second : IdHashIndex::kNotFound);
+        }
+        TEST_CHECK(lookupsMatch);
+        index.clear();
+        TEST_CHECK(index.empty() && index.find(0) == IdHashIndex::kNotFound);
+        qDebug() << "  ✓ set/find/erase match std::map\n";
+    }
+
+    static void testBalancedBST()
+    {
+        qDebug() << "TEST: BalancedBST";
+        
+        // Keys arriving in sorted order must not degenerate into a list
+        BalancedBST tree;
+        const int count = 10000;
+        for (int i = 0; i < count; i++) {
+            QString key = QString("judul %1").arg(i, 5, 10, QChar('0'));
+            tree.insert(key, Book(i + 1, key, "x", QStringList{"Fiksi"}, 2000, 4.0));
+        }
+        TEST_CHECK(tree.size() == static_cast<size_t>(count));
+        TEST_CHECK(tree.height() <= 20);  // AVL bound: < 1.45 * log2(10000)
+        TEST_CHECK(!tree.insert("judul 00042", Book(99999, "dup", "x", QStringList{"Fiksi"}, 2000, 4.0)));
+        TEST_CHECK(tree.find("judul 00042") && tree.find("judul 00042")->getId() == 43);
+        TEST_CHECK(tree.find("judul 10000") == nullptr);
+        
+        QString previous;
+        bool inOrder = true;
+        size_t visited = 0;
+        tree.inOrder([&](const QString& key, const Book&) {
+            inOrder = inOrder && (visited == 0 || QString::compare(previous, key) < 0);
+            previous = key;
+            visited++;
+        });
+        TEST_CHECK(inOrder && visited == tree.size());
+        
+        // Bulk load from sorted keys gives the same tree contents with minimal height
+        BalancedBST bulk;
+        bulk.assignSorted(count, [](size_t i) { return QString("judul %1").arg(i, 5, 10, QChar('0')); },
+                          [](size_t i) { return Book(static_cast<int>(i) + 1, "", "x", QStringList{"Fiksi"}, 2000, 4.0); });
+        TEST_CHECK(bulk.size() == tree.size() && bulk.height() == 14);  // ceil(log2(10001))
+        TEST_CHECK(bulk.find("judul 00042") && bulk.find("judul 00042")->getId() == 43);
+        TEST_CHECK(bulk.insert("judul 99999", Book(99999, "", "x", QStringList{"Fiksi"}, 2000, 4.0)));
+        qDebug() << "  ✓ insert/find/inOrder/assignSorted work, height stays logarithmic";
+        
+        // BookManager: case-insensitive lookup, first book wins on duplicate titles
+        BookManager manager;
+        manager.addBook(Book(1, "Laskar Pelangi", "Andrea Hirata", QStringList{"Fiksi"}, 2005, 4.5));
+        manager.addBook(Book(2, "Bumi Manusia", "Pramoedya", QStringList{"Sejarah"}, 1980, 4.8));
+        manager.addBook(Book(3, "laskar pelangi", "Lain", QStringList{"Fiksi"}, 2010, 3.0));
+        manager.buildBST();
+        TEST_CHECK(manager.searchBST("LASKAR PELANGI") && manager.searchBST("LASKAR PELANGI")->getId() == 1);
+        std::vector<Book> inOrderBooks = manager.getBSTInOrder();
+        TEST_CHECK(inOrderBooks.size() == 2 && inOrderBooks[0].getId() == 2 && inOrderBooks[1].getId() == 1);
+        TEST_CHECK(manager.searchBSTPartial("pelangi").size() == 1);
+        
+        // The bulk-loaded BST matches AVL inserts on a catalog with colliding titles
+        BookManager catalog;
+        catalog.setBooks(makeSyntheticCatalog(5000));
+        mutateCatalog(catalog, 2000, 31);
+        catalog.buildBST();
+        BalancedBST reference;
+        for (const Book& book : catalog.books()) reference.insert(book.getJudul().toLower(), book);
+        std::vector<int> expectedIds, bulkIds;
+        reference.inOrder([&](const QString&, const Book& book) { expectedIds.push_back(book.getId()); });
+        for (const Book& book : catalog.getBSTInOrder()) bulkIds.push_back(book.getId());
+        TEST_CHECK(expectedIds == bulkIds);
+        qDebug() << "  ✓ BookManager BST search works\n";
+    }
+
+    static void testTrigramIndex()
+    {
+        qDebug() << "TEST: TrigramIndex";
+        
+        TrigramIndex index;
+        index.insert(1, "Laskar Pelangi");
+        index.insert(2, "Bumi Manusia");
+        index.insert(3, "Sang Pemimpi");
+        TEST_CHECK((index.findContaining("PELANG") == std::vector<int>{1}));
+        TEST_CHECK((index.findContaining("ma") == std::vector<int>{2}));  // Under 3 characters: no trigram
+        TEST_CHECK((index.findContaining("an") == std::vector<int>{1, 2, 3}));
+        TEST_CHECK(index.findContaining("xyz").empty());
+        TEST_CHECK(index.estimateContaining("xyz") == 0);
+        TEST_CHECK(index.estimateContaining("pelangi") >= 1);
+        TEST_CHECK(index.estimateContaining("an") == index.size());
+        qDebug() << "  ✓ findContaining/estimateContaining work";
+        
+        index.insert(1, "Ayat Ayat Cinta");  // Replaces the text of book 1
+        TEST_CHECK(index.findContaining("pelangi").empty());
+        TEST_CHECK((index.findContaining("cinta") == std::vector<int>{1}));
+        TEST_CHECK(index.textOf(1) && *index.textOf(1) == "ayat ayat cinta");
+        TEST_CHECK(index.erase(2) && !index.erase(2));
+        TEST_CHECK(index.findContaining("manusia").empty() && index.size() == 2);
+        qDebug() << "  ✓ insert (replace) and erase work";
+        
+        std::vector<std::pair<int, int>> similar = index.findSimilar("Sang Pemimpl", 1);
+        TEST_CHECK(similar.size() == 1 && similar[0].first == 3 && similar[0].second == 1);
+        TEST_CHECK(index.findSimilar("Sang Pemimpl", 0).empty());
+        qDebug() << "  ✓ findSimilar() works";
+        
+        // BookManager lookups match a brute-force scan after updates
+        BookManager manager;
+        manager.setBooks(makeSyntheticCatalog(3000));
+        mutateCatalog(manager, 1500, 13);
+        bool matches = true;
+        for (const QString& fragment : {QString("an"), QString("ar"), QString("ing"), QString("PENULIS 1")}) {
+            for (bool includeAuthor : {false, true}) {
+                std::vector<int> expected;
+                for (const Book& book : manager.books()) {
+                    if (book.getJudul().contains(fragment, Qt::CaseInsensitive) ||
+                        (includeAuthor && book.getPenulis().contains(fragment, Qt::CaseInsensitive))) {
+                        expected.push_back(book.getId());
+                    }
+                }
+                std::sort(expected.begin(), expected.end());
+                matches = matches && manager.findIdsContaining(fragment, includeAuthor) == expected;
+            }
+        }
+        TEST_CHECK(matches);
+        const Book& first = manager.books().front();
+        const Book* byTitle = manager.findByTitle(first.getJudul().toUpper());
+        TEST_CHECK(byTitle && byTitle->getJudul().compare(first.getJudul(), Qt::CaseInsensitive) == 0);
+        TEST_CHECK(manager.findByTitle("judul yang tidak ada") == nullptr);
+        qDebug() << "  ✓ findIdsContaining/findByTitle match a scan\n";
+    }
+
+    static void testPrefixTrie()
+    {
+        qDebug() << "TEST: PrefixTrie";
+        
+        PrefixTrie trie;
+        trie.insert("Laskar Pelangi", 1, 45);
+        trie.insert("laskar pelangi", 2, 30);  // Same folded key: reported once, best ID wins
+        trie.insert("Laut Bercerita", 3, 40);
+        trie.insert("Bumi Manusia", 4, 48);
+        std::vector<PrefixTrie::Completion> top = trie.complete("LA", 5);
+        TEST_CHECK(top.size() == 2 && top[0].id == 1 && top[1].id == 3);
+        TEST_CHECK(trie.complete("las", 5).size() == 1 && trie.complete("", 1)[0].id == 4);
+        TEST_CHECK(trie.complete("lasx", 5).empty());
+        TEST_CHECK(trie.erase("laskar pelangi", 1) && !trie.erase("laskar pelangi", 1));
+        TEST_CHECK(trie.complete("laskar", 5).size() == 1 && trie.complete("laskar", 5)[0].id == 2);
+        qDebug() << "  ✓ insert/complete/erase work";
+        
+        // Top-k after random inserts and erases matches a brute-force ranking
+        std::map<int, std::pair<QString, qint32>> stored;  // id -> (folded key, score)
+        SyntheticRandom random(2024);
+        trie.clear();
+        for (int i = 0; i < 6000; i++) {
+            int id = 1 + random.next() % 2000;
+            auto it = stored.find(id);
+            if (it != stored.end()) {
+                trie.erase(it->second.first, id);
+                stored.erase(it);
+            }
+            if (random.next() % 3 != 0) {
+                QString key = random.words(1 + random.next() % 2);
+                trie.insert(key, id, id * 7 % 2003);  // Distinct scores keep the ranking unambiguous
+                stored[id] = std::make_pair(key.toLower(), id * 7 % 2003);
+            }
+        }
+        TEST_CHECK(trie.size() == stored.size());
+        bool matches = true;
+        for (const QString& prefix : {QString(""), QString("b"), QString("ka"), QString("ma"), QString("tu")}) {
+            std::map<QString, std::pair<qint32, int>> bestPerKey;  // key -> (score, id)
+            for (const auto& entry : stored) {
+                if (!entry.second.first.startsWith(prefix)) continue;
+                auto best = bestPerKey.find(entry.second.first);
+                if (best == bestPerKey.end() || best->second.first < entry.second.second) {
+                    bestPerKey[entry.second.first] = std::make_pair(entry.second.second, entry.first);
+                }
+            }
+            std::vector<std::pair<qint32, int>> expected;
+            for (const auto& entry : bestPerKey) expected.push_back(entry.second);
+            std::sort(expected.begin(), expected.end(), std::greater<std::pair<qint32, int>>());
+            if (expected.size() > 10) expected.resize(10);
+            std::vector<PrefixTrie::Completion> got = trie.complete(prefix, 10);
+            matches = matches && got.size() == expected.size();
+            for (size_t i = 0; matches && i < got.size(); i++) matches = got[i].id == expected[i].second;
+        }
+        TEST_CHECK(matches);
+        
+        // BookManager merges title and author suggestions in their original spelling
+        BookManager manager;
+        manager.addBook(Book(1, "Laskar Pelangi", "Andrea Hirata", QStringList{"Fiksi"}, 2005, 4.5));
+        manager.addBook(Book(2, "Bumi Manusia", "Pramoedya", QStringList{"Sejarah"}, 1980, 4.8));
+        manager.addBook(Book(3, "Antologi", "Laila", QStringList{"Puisi"}, 2015, 4.9));
+        TEST_CHECK((manager.completePrefix("la") == QStringList{"Laila", "Laskar Pelangi"}));
+        TEST_CHECK(manager.completePrefix("la", 1).size() == 1);
+        qDebug() << "  ✓ complete() matches a brute-force top-k after edits, completePrefix() works\n";
+    }
+
+    static void testSearchSession()
+    {
+        qDebug() << "TEST: SearchSession";
+        
+        BookManager manager;
+        manager.setBooks(makeSyntheticCatalog(3000));
+        SearchSession session(manager);
+        
+        // Typing, backspace and a paste elsewhere all give the same IDs as a full lookup
+        bool matches = true;
+        bool refinedWhileTyping = true;
+        QString typed;
+        for (const QString& step : {QString("a"), QString("an"), QString("ang"), QString("an"), QString("ka"), QString("kar")}) {
+            bool extends = !typed.isEmpty() && step.contains(typed);
+            const std::vector<int>& ids = session.find(step);
+            matches = matches && ids == manager.findIdsContaining(step, true);
+            if (extends) refinedWhileTyping = refinedWhileTyping && session.lastWasRefined();
+            typed = step;
+        }
+        TEST_CHECK(matches);
+        TEST_CHECK(refinedWhileTyping);
+        
+        // A catalog change invalidates the cached steps
+        manager.addBook(Book(99999, "Karya Baru", "x", QStringList{"Fiksi"}, 2024, 4.0));
+        const std::vector<int>& afterAdd = session.find("kar");
+        TEST_CHECK(!session.lastWasRefined());
+        TEST_CHECK(std::binary_search(afterAdd.begin(), afterAdd.end(), 99999));
+        qDebug() << "  ✓ find() narrows cached hits and resets on catalog changes";
+        
+        // Read views: one copy per version, unaffected by later changes to the manager
+        BookManager::ReadView view = manager.getReadView();
+        TEST_CHECK(manager.getReadView() == view);
+        TEST_CHECK(manager.getSnapshot().get() == &view->books());
+        size_t viewSize = view->books().size();
+        manager.removeBook(99999);
+        TEST_CHECK(manager.getReadView() != view && view->books().size() == viewSize);
+        TEST_CHECK(view->getSlotById(99999) != BookManager::kNoSlot && manager.getSlotById(99999) == BookManager::kNoSlot);
+        
+        // A session without a bound manager searches whichever view it is given
+        SearchSession detached;
+        const std::vector<int>& inOldView = detached.find(*view, "karya baru");
+        TEST_CHECK((inOldView == std::vector<int>{99999}));
+        TEST_CHECK(detached.find(*manager.getReadView(), "karya baru").empty());
+        qDebug() << "  ✓ read views are shared per version and searchable from a detached session\n";
+    }
+
+    static void testFuzzySearch()
+    {
+        qDebug() << "TEST: Fuzzy title search";
+        
+        std::vector<ushort> pattern = {'k', 'i', 't', 't', 'e', 'n'};
+        std::vector<ushort> text = {'s', 'i', 't', 't', 'i', 'n', 'g'};
+        Searching::EditDistanceMatcher<ushort> matcher(pattern.data(), pattern.size());
+        TEST_CHECK(matcher.distance(text.data(), text.size(), 5) == 3);
+        TEST_CHECK(matcher.distance(text.data(), text.size(), 2) == 3);  // Bounded: k + 1
+        qDebug() << "  ✓ EditDistanceMatcher works";
+        
+        BookManager manager;
+        manager.addBook(Book(1, "Laskar Pelangi", "Andrea Hirata", QStringList{"Novel"}, 2005, 4.8));
+        manager.addBook(Book(2, "Bumi Manusia", "Pramoedya", QStringList{"Novel"}, 1980, 4.9));
+        manager.addBook(Book(3, "Laskar Pelangi 2", "Andrea Hirata", QStringList{"Novel"}, 2007, 4.1));
+        
+        std::vector<Book> results = manager.fuzzySearchByTitle("Laskar Pelngi", 2);
+        TEST_CHECK(results.size() == 1);
+        TEST_CHECK(results[0].getId() == 1);
+        results = manager.fuzzySearchByTitle("laskar pelangi", 2);
+        TEST_CHECK(results.size() == 2);
+        TEST_CHECK(results[0].getId() == 1);  // Exact match ranks first
+        TEST_CHECK(manager.fuzzySearchByTitle("Bumi Manusia", 0).size() == 1);
+        qDebug() << "  ✓ fuzzySearchByTitle() works\n";
+    }
+
+    static void testRoaringBitmap()
+    {
+        qDebug() << "TEST: RoaringBitmap";
+        
+        // dense: > 4096 values per chunk (bitset), sparse: array chunks
+        RoaringBitmap dense, sparse;
+        for (uint32_t value = 0; value < 200000; value += 3) dense.add(value);
+        for (uint32_t value = 5; value < 200000; value += 997) sparse.add(value);
+        TEST_CHECK(dense.cardinality() == 66667);
+        TEST_CHECK(!dense.add(3) && dense.contains(3) && !dense.contains(4));
+        
+        size_t expectedBoth = 0;
+        for (uint32_t value = 5; value < 200000; value += 997) expectedBoth += value % 3 == 0;
+        RoaringBitmap both = RoaringBitmap::intersect(sparse, dense);
+        RoaringBitmap either = RoaringBitmap::unite(sparse, dense);
+        TEST_CHECK(both.cardinality() == expectedBoth);
+        TEST_CHECK(either.cardinality() == dense.cardinality() + sparse.cardinality() - expectedBoth);
+        std::vector<uint32_t> values = both.toVector();
+        TEST_CHECK(values.size() == expectedBoth && std::is_sorted(values.begin(), values.end()));
+        bool allMultiples = true;
+        both.forEach([&](uint32_t value) { allMultiples = allMultiples && value % 3 == 0 && sparse.contains(value); });
+        TEST_CHECK(allMultiples);
+        qDebug() << "  ✓ intersect/unite across array and bitset chunks work";
+        
+        TEST_CHECK(dense.remove(3) && !dense.remove(3) && dense.cardinality() == 66666);
+        for (uint32_t value = 0; value < 200000; value += 3) dense.remove(value);
+        TEST_CHECK(dense.empty() && dense.cardinality() == 0);
+        qDebug() << "  ✓ add/remove work";
+        
+        // Genre index: keys normalized with Book::genreKey (case and surrounding spaces ignored)
+        BookManager manager;
+        manager.addBook(Book(1, "Laskar Pelangi", "Andrea Hirata", QStringList{" Fiksi ", "Drama"}, 2005, 4.5));
+        manager.addBook(Book(2, "Bumi Manusia", "Pramoedya", QStringList{"fiksi", "Sejarah"}, 1980, 4.8));
+        manager.addBook(Book(3, "Antologi", "Laila", QStringList{"Puisi"}, 2015, 4.9));
+        TEST_CHECK(manager.getGenreBitmap("FIKSI ") && manager.getGenreBitmap("FIKSI ")->cardinality() == 2);
+        TEST_CHECK(manager.countByGenre("fiksi") == 2 && manager.countByGenre(" drama") == 1);
+        TEST_CHECK(manager.searchByGenres(QStringList{"Fiksi", "Sejarah"}, true).size() == 1);
+        TEST_CHECK(manager.searchByGenres(QStringList{"Drama", "Puisi"}, false).size() == 2);
+        TEST_CHECK(manager.getAllBooks()[0].hasGenre("fiksi"));
+        manager.updateBook(Book(1, "Laskar Pelangi", "Andrea Hirata", QStringList{"Drama "}, 2005, 4.5));
+        TEST_CHECK(manager.countByGenre("Fiksi") == 1 && manager.countByGenre("drama") == 1);
+        manager.removeBook(3);
+        TEST_CHECK(manager.getGenreBitmap("puisi") == nullptr);
+        BookManager reloaded;
+        reloaded.setBooks(manager.getAllBooks());  // Bulk rebuild uses the same keys
+        TEST_CHECK(reloaded.countByGenre(" FIKSI") == 1 && reloaded.countByGenre("Drama") == 1);
+        qDebug() << "  ✓ genre index follows add/update/remove with normalized keys\n";
+    }
+
+    static void testRangeIndex()
+    {
+        qDebug() << "TEST: RangeIndex";
+        
+        // Far more than 2 x kBlockSize entries: blocks are split, then merged again
+        RangeIndex index;
+        std::vector<RangeIndex::Entry> reference;
+        SyntheticRandom random(4242);
+        for (int id = 0; id < 6000; id++) {
+            RangeIndex::Entry entry{static_cast<qint32>(random.next() % 2000) - 1000, id};
+            index.insert(entry.key, entry.id);
+            reference.push_back(entry);
+        }
+        std::sort(reference.begin(), reference.end());
+        
+        auto matchesReference = [&]() {
+            if (index.size() != reference.size()) return false;
+            if (!std::equal(index.begin(), index.end(), reference.begin(), reference.end(),
+                            [](const RangeIndex::Entry& a, const RangeIndex::Entry& b) { return a.key == b.key && a.id == b.id; })) {
+                return false;
+            }
+            for (qint32 value = -1010; value <= 1010; value += 7) {
+                RangeIndex::Entry first{value, std::numeric_limits<int>::min()};
+                RangeIndex::Entry last{value + 50, std::numeric_limits<int>::max()};
+                auto from = std::lower_bound(reference.begin(), reference.end(), first);
+                auto to = std::upper_bound(reference.begin(), reference.end(), last);
+                RangeIndex::View view = index.range(value, value + 50);
+                size_t rank = static_cast<size_t>(from - reference.begin());
+                if (index.rank(value) != rank || index.countAtLeast(value) != reference.size() - rank) return false;
+                if (index.count(value, value + 50) != static_cast<size_t>(to - from)) return false;
+                if (!std::equal(view.begin(), view.end(), from, to,
+                                [](const RangeIndex::Entry& a, const RangeIndex::Entry& b) { return a.id == b.id; })) {
+                    return false;
+                }
+            }
+            for (size_t i = 0; i < reference.size(); i += 97) {
+                if (index.select(i).id != reference[i].id || (index.begin() + i)->id != reference[i].id) return false;
+            }
+            if (!reference.empty() && std::prev(index.end())->id != reference.back().id) return false;
+            return index.count(10, -10) == 0 && index.range(10, -10).empty();
+        };
+        TEST_CHECK(matchesReference());
+        qDebug() << "  ✓ insert/rank/select/range/count match a sorted vector";
+        
+        // Remove about 90% of the entries
+        bool erased = true;
+        for (const RangeIndex::Entry& entry : reference) {
+            if (entry.id % 10 != 0) erased = erased && index.erase(entry.key, entry.id);
+        }
+        reference.erase(std::remove_if(reference.begin(), reference.end(),
+                                       [](const RangeIndex::Entry& entry) { return entry.id % 10 != 0; }),
+                        reference.end());
+        TEST_CHECK(erased);
+        TEST_CHECK(!index.erase(reference.front().key, -1));
+        TEST_CHECK(matchesReference());
+        
+        index.assign(reference);
+        TEST_CHECK(matchesReference());
+        qDebug() << "  ✓ erase and assign keep the order";
+        
+        // BookManager range queries match a brute-force scan after updates
+        BookManager manager;
+        manager.setBooks(makeSyntheticCatalog(3000));
+        mutateCatalog(manager, 1500, 17);
+        auto ids = [](const std::vector<Book>& books) {
+            std::vector<int> result;
+            for (const Book& book : books) result.push_back(book.getId());
+            return result;
+        };
+        std::vector<int> inYears, inRatings;
+        std::vector<std::pair<qint32, int>> popular;
+        for (const Book& book : manager.books()) {
+            qint32 rating = BookManager::ratingKey(book.getRating());
+            if (book.getTahun() >= 1980 && book.getTahun() <= 1989) inYears.push_back(book.getId());
+            if (rating >= BookManager::ratingKey(2.5) && rating <= BookManager::ratingKey(3.5)) inRatings.push_back(book.getId());
+            if (rating >= BookManager::ratingKey(4.5)) popular.emplace_back(rating, book.getId());
+        }
+        // Best first; equal ratings by ascending ID
+        std::sort(popular.begin(), popular.end(), [](const std::pair<qint32, int>& a, const std::pair<qint32, int>& b) {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+        std::vector<int> popularIds;
+        for (const auto& entry : popular) popularIds.push_back(entry.second);
+        TEST_CHECK(ids(manager.searchByYearRange(1980, 1989)) == inYears);
+        TEST_CHECK(manager.countByYearRange(1980, 1989) == inYears.size());
+        TEST_CHECK(ids(manager.searchByRatingRange(2.5, 3.5)) == inRatings);
+        TEST_CHECK(manager.countByRatingRange(2.5, 3.5) == inRatings.size());
+        TEST_CHECK(ids(manager.getPopularBooks(4.5)) == popularIds);
+        TEST_CHECK(manager.countPopularBooks(4.5) == popularIds.size());
+        TEST_CHECK((ids(manager.getPopularBooks(4.5, 3, 5)) == std::vector<int>(popularIds.begin() + 3, popularIds.begin() + 8)));
+        TEST_CHECK(manager.getPopularBooks(4.5, popularIds.size(), 5).empty());
+        TEST_CHECK(manager.countByYearRange(1990, 1980) == 0 && manager.searchByYearRange(1990, 1980).empty());
+        qDebug() << "  ✓ searchBy*Range/countBy*Range/getPopularBooks/countPopularBooks match a scan\n";
+    }
+
+    static void testQueryEngine()
+    {
+        qDebug() << "TEST: QueryEngine";
+        
+        BookManager manager;
+        manager.setBooks(makeSyntheticCatalog(3000));
+        mutateCatalog(manager, 600, 31);
+        QueryEngine engine(manager);
+        
+        // Exact estimates for genre and year; an upper bound for text
+        BookQuery genreQuery;
+        genreQuery.genres << "sejarah";
+        TEST_CHECK(engine.estimate(genreQuery) == manager.countByGenre("Sejarah"));
+        BookQuery yearQuery;
+        yearQuery.minYear = 1980;
+        yearQuery.maxYear = 1989;
+        TEST_CHECK(engine.estimate(yearQuery) == manager.countByYearRange(1980, 1989));
+        TEST_CHECK(engine.estimate(yearQuery) == engine.run(yearQuery).size());
+        BookQuery textQuery;
+        textQuery.text = "lan";
+        TEST_CHECK(engine.estimate(textQuery) >= engine.run(textQuery).size());
+        qDebug() << "  ✓ estimate() is exact for genre/year and an upper bound for text";
+        
+        // Compare against brute-force filtering
+        static const char* const genres[] = {"Fiksi", "Sejarah", "Sains", "Puisi", "Horror"};
+        SyntheticRandom random(2024);
+        const std::vector<Book>& books = manager.books();
+        int mismatches = 0;
+        for (int round = 0; round < 400; round++) {
+            BookQuery query;
+            std::vector<int> candidates;
+            if (random.next() % 3 == 0) query.text = random.word().left(1 + random.next() % 4);
+            query.textInAuthor = random.next() % 2;
+            if (random.next() % 4 == 0) {
+                for (int id = 1; id <= 6000; id++) {
+                    if (random.next() % 20 == 0) candidates.push_back(id);
+                }
+                query.candidateIds = &candidates;
+            }
+            if (random.next() % 3 == 0) {
+                query.genres << genres[random.next() % 5];
+                if (random.next() % 2) query.genres << genres[random.next() % 5];
+                query.matchAllGenres = random.next() % 2;
+            }
+            if (random.next() % 3 == 0) {
+                query.minYear = 1950 + random.next() % 75;
+                query.maxYear = query.minYear + random.next() % 20;
+            }
+            if (random.next() % 3 == 0) {
+                query.minRating = (random.next() % 51) / 10.0;
+                query.maxRating = query.minRating + (random.next() % 20) / 10.0;
+            }
+            query.ordered = random.next() % 2;
+            query.orderBy = static_cast<BookManager::SortField>(random.next() % 4);
+            query.ascending = random.next() % 2;
+            query.limit = random.next() % 2 ? 0 : 1 + random.next() % 50;
+        
+            QString folded = query.text.toLower();
+            std::vector<uint32_t> expected;
+            for (uint32_t slot = 0; slot < books.size(); slot++) {
+                const Book& book = books[slot];
+                if (!folded.isEmpty() && !book.getJudul().toLower().contains(folded)
+                    && !(query.textInAuthor && book.getPenulis().toLower().contains(folded))) continue;
+                if (query.candidateIds && !std::binary_search(candidates.begin(), candidates.end(), book.getId())) continue;
+                if (!query.genres.isEmpty()) {
+                    int hits = 0;
+                    for (const QString& genre : query.genres) hits += book.hasGenre(genre);
+                    if (query.matchAllGenres ? hits != static_cast<int>(query.genres.size()) : hits == 0) continue;
+                }
+                if (book.getTahun() < query.minYear || book.getTahun() > query.maxYear) continue;
+                qint32 rating = BookManager::ratingKey(book.getRating());
+                if (rating < BookManager::ratingKey(query.minRating) || rating > BookManager::ratingKey(query.maxRating)) continue;
+                expected.push_back(slot);
+            }
+            if (query.ordered) manager.sortIndices(books, expected, query.orderBy, query.ascending);
+            if (query.limit > 0 && expected.size() > query.limit) expected.resize(query.limit);
+            mismatches += engine.run(query) != expected;
+        }
+        TEST_CHECK(mismatches == 0);
+        qDebug() << "  ✓ run() matches brute force (filters, order, limit)";
+        
+        // No filter and no limit: walks the secondary index
+        BookQuery everything;
+        everything.ordered = true;
+        everything.orderBy = BookManager::SortField::Author;
+        everything.ascending = false;
+        std::vector<uint32_t> walked = engine.run(everything);
+        std::vector<int> walkedIds;
+        for (uint32_t slot : walked) walkedIds.push_back(books[slot].getId());
+        TEST_CHECK(walkedIds == idsInSortOrder(manager, BookManager::SortField::Author, false));
+        
+        int polls = 0;
+        TEST_CHECK(engine.run(yearQuery, [&polls]() { polls++; return true; }).empty());
+        TEST_CHECK(polls > 0);
+        qDebug() << "  ✓ ordered walk and cancellation work\n";
+    }
+    static void testCatalogStats()
+    {
+        qDebug() << "TEST: CatalogStats (exact mode)";
+        
+        BookManager manager;
+        manager.setStatsMode(CatalogStats::Mode::Exact);
+        manager.setBooks(makeSyntheticCatalog(3000));
+        mutateCatalog(manager, 1500, 11);
+        
+        // Recount everything from the collection
+        std::set<QString> authors;
+        std::map<QString, int> genreCounts;
+        std::map<int, int> ratingHistogram, decadeHistogram;
+        qint64 ratingSum = 0;
+        for (const Book& book : manager.books()) {
+            authors.insert(book.getPenulis());
+            for (const QString& genre : book.getGenre()) genreCounts[genre.trimmed()]++;
+            ratingHistogram[CatalogStats::ratingBucket(book.getRating())]++;
+            decadeHistogram[CatalogStats::decadeOf(book.getTahun())]++;
+            ratingSum += Book::ratingKey(book.getRating());
+        }
+        const CatalogStats& stats = manager.getStats();
+        size_t bookCount = manager.books().size();
+        TEST_CHECK(stats.bookCount() == bookCount);
+        TEST_CHECK(stats.authorCount() == authors.size());
+        TEST_CHECK(stats.genreCount() == genreCounts.size());
+        TEST_CHECK(stats.genreCounts() == genreCounts);
+        TEST_CHECK(stats.ratingHistogram() == ratingHistogram);
+        TEST_CHECK(stats.decadeHistogram() == decadeHistogram);
+        TEST_CHECK(std::abs(stats.averageRating() - ratingSum / Book::kRatingScale / bookCount) < 1e-9);
+        TEST_CHECK(stats.ratingBucketCount(4) == ratingHistogram[4]);
+        TEST_CHECK(manager.getReadView()->getStats().genreCounts() == genreCounts);
+        qDebug() << "  ✓ aggregates match a full recount after add/remove/update";
+        
+        // One rounding rule for the rating index, the sort keys and the rating sum
+        TEST_CHECK(Book::ratingKey(4.75) == 475 && Book::ratingKey(4.754) == 475 && Book::ratingKey(4.755) == 476);
+        TEST_CHECK(BookManager::ratingKey(3.3) == Book::ratingKey(3.3));
+        TEST_CHECK(Book::ratingKey(std::numeric_limits<double>::max()) == std::numeric_limits<qint32>::max());
+        TEST_CHECK(Book::ratingKey(std::numeric_limits<double>::lowest()) == std::numeric_limits<qint32>::min());
+        qDebug() << "  ✓ Book::ratingKey() rounds and clamps";
+        
+        while (manager.getBookCount() > 0) manager.removeBook(manager.books().back().getId());
+        TEST_CHECK(manager.getStats().bookCount() == 0 && manager.getStats().authorCount() == 0);
+        TEST_CHECK(manager.getStats().genreCounts().empty() && manager.getStats().averageRating() == 0.0);
+        qDebug() << "  ✓ removing every book empties the stats";
+        
+        // Sketch mode: book count, rating and decade data stay exact, distinct counts are estimates
+        BookManager sketched;
+        sketched.setStatsMode(CatalogStats::Mode::Sketch);
+        sketched.setBooks(makeSyntheticCatalog(20000));
+        mutateCatalog(sketched, 6000, 12);
+        std::set<QString> sketchedAuthors;
+        std::map<int, int> sketchedRatings;
+        for (const Book& book : sketched.books()) {
+            sketchedAuthors.insert(book.getPenulis());
+            sketchedRatings[CatalogStats::ratingBucket(book.getRating())]++;
+        }
+        const CatalogStats& estimates = sketched.getStats();
+        double authorError = std::abs(static_cast<double>(estimates.authorCount()) - sketchedAuthors.size());
+        TEST_CHECK(estimates.mode() == CatalogStats::Mode::Sketch);
+        TEST_CHECK(estimates.bookCount() == sketched.books().size());
+        TEST_CHECK(estimates.ratingHistogram() == sketchedRatings);
+        TEST_CHECK(authorError < sketchedAuthors.size() * 0.05);
+        qDebug() << "  ✓ sketch mode estimates" << estimates.authorCount() << "authors for" << sketchedAuthors.size() << "\n";
+    }
+    static void testBookStore()
+    {
+        qDebug() << "TEST: BookStore";
+        
+        BookManager manager;
+        manager.setBooks(makeSyntheticCatalog(2000));
+        manager.addBook(Book(9001, "Tahun Jauh", "Penulis", QStringList{"Fiksi"}, 100000, 4.5));  // > int16
+        manager.addBook(Book(9002, "Sebelum Masehi", "Penulis", QStringList{"Sejarah"}, -40000, 3.25));
+        mutateCatalog(manager, 800, 5);
+        
+        auto alignedWithBooks = [&manager]() {
+            const BookStore& store = manager.getBookStore();
+            const std::vector<Book>& books = manager.books();
+            if (store.size() != books.size()) return false;
+            for (size_t slot = 0; slot < books.size(); slot++) {
+                const Book& book = books[slot];
+                if (store.id(slot) != book.getId() || store.year(slot) != book.getTahun()) return false;
+                if (store.ratingKey(slot) != BookManager::ratingKey(book.getRating())) return false;
+                for (const QString& genre : book.getGenre()) {
+                    if ((store.genreMasks()[slot] & store.genreBit(genre)) == 0) return false;
+                }
+            }
+            return true;
+        };
+        TEST_CHECK(alignedWithBooks());
+        manager.quickSortByYear(false);
+        TEST_CHECK(alignedWithBooks());
+        manager.quickSortByRating(true);
+        TEST_CHECK(alignedWithBooks());
+        manager.quickSortByTitle(true);
+        TEST_CHECK(alignedWithBooks());
+        manager.quickSortByAuthor(false);
+        TEST_CHECK(alignedWithBooks());
+        qDebug() << "  ✓ columns stay aligned through add/remove/update and sorts";
         
-        // Test Jump Search
-        idx = Searching::jumpSearch(sortedArr, 9);
-        Q_ASSERT(idx == 4);
-        qDebug() << "  ✓ Jump Search works\n";
+        const BookStore& store = manager.getBookStore();
+        uint32_t slot = manager.getSlotById(9001);
+        TEST_CHECK(slot != BookManager::kNoSlot && store.year(slot) == 100000);
+        slot = manager.getSlotById(9002);
+        TEST_CHECK(slot != BookManager::kNoSlot && store.year(slot) == -40000 && store.ratingKey(slot) == 325);
+        TEST_CHECK(store.genreBit("FIKSI") != 0 && store.genreBit("FIKSI") == store.genreBit("fiksi"));
+        TEST_CHECK(store.genreBit(" Fiksi ") == store.genreBit("fiksi"));
+        TEST_CHECK(store.genreBit("Tidak Ada") == 0);
+        TEST_CHECK(store.columnBytes() == store.size() * 20);
+        qDebug() << "  ✓ wide years, fixed-point ratings and genre bits work\n";
     }
 };
 
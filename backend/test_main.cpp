@@ -0,0 +1,20 @@
+#include "test_backend.h"
+#include <QCoreApplication>
+
+/**
+ * @file test_main.cpp
+ * @brief Runner for the backend tests (registered with ctest as backend_tests)
+ *
+ * Exits non-zero when any check fails. Pass --benchmark to also run the
+ * benchmarks on large synthetic catalogs.
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int failures = TestBackend::runAllTests();
+    if (app.arguments().contains("--benchmark")) {
+        TestBackend::runAllBenchmarks();
+    }
+    return failures == 0 ? 0 : 1;
+}
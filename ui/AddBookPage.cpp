@@ -421,7 +421,7 @@ void AddBookPage::onBrowseImage()
 
 int AddBookPage::generateNewId()
 {
-    std::vector<Book> books = DatabaseManager::instance().getAllBooks();
+    const std::vector<Book>& books = DatabaseManager::instance().getBookManager().books();
     if (books.empty()) return 1;
     int maxId = 0;
     for (const Book& book : books) if (book.getId() > maxId) maxId = book.getId();
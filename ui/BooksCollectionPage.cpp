@@ -8,13 +8,17 @@
 #include <QMessageBox>
 #include <QHeaderView>
 #include <QTimer>
+#include <QtConcurrent>
 #include <set>
 // TIDAK menggunakan <algorithm> karena kita pakai struktur data sendiri!
 
 BooksCollectionPage::BooksCollectionPage(QWidget *parent)
     : QWidget(parent)
+    , m_loadedVersion(0)
+    , m_filterShared(std::make_shared<FilterShared>())
     , m_isCardView(true) 
 {
+    connect(&m_filterWatcher, &QFutureWatcher<FilterResult>::finished, this, &BooksCollectionPage::onFilterFinished);
     setupUI();
     // Panggil refreshTable di awal untuk load data
     refreshTable();
@@ -22,6 +26,9 @@ BooksCollectionPage::BooksCollectionPage(QWidget *parent)
 
 BooksCollectionPage::~BooksCollectionPage()
 {
+    // Batalkan query yang sedang jalan dan tunggu worker selesai sebelum member dihapus
+    ++m_filterShared->generation;
+    m_filterWatcher.waitForFinished();
 }
 
 void BooksCollectionPage::setupUI()
@@ -122,6 +129,20 @@ void BooksCollectionPage::createControlSection(QVBoxLayout* containerLayout)
     m_searchBox->setStyleSheet(inputStyle);
     toolbarLayout->addWidget(m_searchBox, 1);
 
+    // Autocomplete: daftar saran diisi ulang dari prefix trie setiap kali user mengetik
+    m_completionModel = new QStringListModel(this);
+    m_searchCompleter = new QCompleter(m_completionModel, this);
+    m_searchCompleter->setCaseSensitivity(Qt::CaseInsensitive);
+    m_searchCompleter->setCompletionMode(QCompleter::PopupCompletion);
+    m_searchCompleter->setMaxVisibleItems(kMaxSearchSuggestions);
+    m_searchBox->setCompleter(m_searchCompleter);
+
+    // Debounce: filter baru dijalankan setelah user berhenti mengetik sebentar
+    m_searchDebounce = new QTimer(this);
+    m_searchDebounce->setSingleShot(true);
+    m_searchDebounce->setInterval(kSearchDebounceMs);
+    connect(m_searchDebounce, &QTimer::timeout, this, &BooksCollectionPage::onFilterChanged);
+
     m_genreCombo = new QComboBox();
     m_genreCombo->setFixedWidth(160);
     m_genreCombo->setStyleSheet(inputStyle);
@@ -170,17 +191,53 @@ void BooksCollectionPage::createControlSection(QVBoxLayout* containerLayout)
     m_bstSearchBox->setFixedWidth(150);
     m_bstSearchBox->setStyleSheet("QLineEdit { background: transparent; border: none; border-bottom: 1px solid #CBD5E1; color: #2B3674; }");
 
+    // Filter rentang: dijawab index tahun/rating yang terurut (lower/upper bound)
+    QString spinStyle = "QSpinBox, QDoubleSpinBox { background: transparent; border: none; border-bottom: 1px solid #CBD5E1; color: #2B3674; }";
+    QLabel* yearLabel = new QLabel("Tahun:");
+    yearLabel->setStyleSheet("color: #64748B; margin-left: 10px;");
+    m_minYearSpin = new QSpinBox();
+    m_maxYearSpin = new QSpinBox();
+    for (QSpinBox* spin : {m_minYearSpin, m_maxYearSpin}) {
+        spin->setRange(0, 2100);
+        spin->setSpecialValueText("Semua");
+        spin->setValue(0);
+        spin->setFixedWidth(80);
+        spin->setStyleSheet(spinStyle);
+    }
+    QLabel* yearDash = new QLabel("-");
+    yearDash->setStyleSheet("color: #64748B;");
+
+    QLabel* ratingLabel = new QLabel("Rating ≥");
+    ratingLabel->setStyleSheet("color: #64748B; margin-left: 10px;");
+    m_minRatingSpin = new QDoubleSpinBox();
+    m_minRatingSpin->setRange(0.0, 5.0);
+    m_minRatingSpin->setSingleStep(0.5);
+    m_minRatingSpin->setSpecialValueText("Semua");
+    m_minRatingSpin->setValue(0.0);
+    m_minRatingSpin->setFixedWidth(70);
+    m_minRatingSpin->setStyleSheet(spinStyle);
+
     bstLayout->addWidget(m_btnBuildBST);
     bstLayout->addWidget(bstLabel);
     bstLayout->addWidget(m_bstSearchBox);
+    bstLayout->addWidget(yearLabel);
+    bstLayout->addWidget(m_minYearSpin);
+    bstLayout->addWidget(yearDash);
+    bstLayout->addWidget(m_maxYearSpin);
+    bstLayout->addWidget(ratingLabel);
+    bstLayout->addWidget(m_minRatingSpin);
     bstLayout->addStretch();
 
     containerLayout->addLayout(bstLayout);
 
     // Connects
     connect(m_searchBox, &QLineEdit::textChanged, this, &BooksCollectionPage::onSearchTextChanged);
+    connect(m_searchBox, &QLineEdit::textEdited, this, &BooksCollectionPage::onSearchTextEdited);
     connect(m_genreCombo, &QComboBox::currentTextChanged, this, &BooksCollectionPage::onFilterChanged);
     connect(m_sortCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &BooksCollectionPage::onFilterChanged);
+    connect(m_minYearSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &BooksCollectionPage::onFilterChanged);
+    connect(m_maxYearSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &BooksCollectionPage::onFilterChanged);
+    connect(m_minRatingSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &BooksCollectionPage::onFilterChanged);
     connect(m_btnToggleView, &QPushButton::clicked, this, &BooksCollectionPage::onToggleView);
     connect(m_btnBuildBST, &QPushButton::clicked, this, &BooksCollectionPage::onBuildBST);
     connect(m_bstSearchBox, &QLineEdit::returnPressed, this, &BooksCollectionPage::onSearchBST);
@@ -284,11 +341,19 @@ QFrame* BooksCollectionPage::createCardFrame()
 
 void BooksCollectionPage::refreshTable()
 {
-    DatabaseManager& dbManager = DatabaseManager::instance();
-    m_currentBooks = dbManager.getAllBooks();
+    // onFilterChanged memuat snapshot baru kalau katalog berubah, lalu render ulang
+    onFilterChanged();
+}
+
+void BooksCollectionPage::reloadSnapshot()
+{
+    BookManager& bookMgr = DatabaseManager::instance().getBookManager();
+    
+    // Read view dibagi dengan pembaca lain: tanpa query SQLite, tanpa copy per halaman
+    m_catalog = bookMgr.getReadView();
+    m_loadedVersion = bookMgr.getVersion();
     
     populateGenreComboBox(); 
-    onFilterChanged();       
 }
 
 void BooksCollectionPage::populateGenreComboBox()
@@ -300,7 +365,7 @@ void BooksCollectionPage::populateGenreComboBox()
     m_genreCombo->addItem("Semua Genre");
     
     std::set<QString> genres;
-    for (const Book& book : m_currentBooks) {
+    for (const Book& book : m_catalog->books()) {
         for (const QString& g : book.getGenre()) {
             if(!g.trimmed().isEmpty()) genres.insert(g.trimmed());
         }
@@ -318,102 +383,143 @@ void BooksCollectionPage::populateGenreComboBox()
 
 void BooksCollectionPage::onFilterChanged()
 {
-    std::vector<Book> filtered = m_currentBooks;
-    
-    // 1. Search Logic - Sesuai Flowchart: Binary Search untuk title, Linear Search untuk lainnya
-    QString search = m_searchBox->text().trimmed();
+    // GUI thread hanya membaca kontrol; search, filter dan sort jalan di worker
+    m_searchDebounce->stop();
+    DatabaseManager& dbMgr = DatabaseManager::instance();
+    BookManager& bookMgr = dbMgr.getBookManager();
     
-    // Check if query empty (tidak perlu warning, langsung tampilkan semua)
-    if (!search.isEmpty()) {
-        DatabaseManager& dbMgr = DatabaseManager::instance();
-        BookManager& bookMgr = dbMgr.getBookManager();
-        QString searchLower = search.toLower();
-        
-        // Cek apakah ini pencarian by Title (exact atau partial title match)
-        // Binary Search O(log n) untuk title search (lebih efisien)
-        std::vector<Book> tempForBinary = filtered;
-        bookMgr.setBooks(tempForBinary);
-        bookMgr.quickSortByTitle(true); // Sort dulu untuk binary search
-        
-        // Coba binary search untuk exact title match dulu
-        Book* exactMatch = bookMgr.binarySearchByTitle(searchLower);
-        
-        if (exactMatch) {
-            // Binary Search: Found exact title match
-            filtered = {*exactMatch};
-        } else {
-            // Linear Search O(n) untuk partial match (judul atau penulis)
-            std::vector<int> indices = Searching::findAll(
-                tempForBinary, 
-                [&searchLower](const Book& b) {
-                    return b.getJudul().toLower().contains(searchLower) || 
-                           b.getPenulis().toLower().contains(searchLower);
-                }
-            );
-            
-            // Convert indices to books
-            filtered.clear();
-            for (int idx : indices) {
-                filtered.push_back(tempForBinary[idx]);
-            }
-        }
-        
-        // Restore original books
-        bookMgr.setBooks(dbMgr.getAllBooks());
+    // Read view hanya dimuat ulang kalau katalog berubah
+    if (!m_catalog || bookMgr.getVersion() != m_loadedVersion) {
+        reloadSnapshot();
     }
     
-    // 2. Genre Filter
+    FilterRequest request;
+    request.catalog = m_catalog;
+    
+    // 1. Search: query kosong tidak membatasi apa pun (langsung tampilkan semua)
+    request.search = m_searchBox->text().trimmed();
+    
+    // 2. Genre filter: QueryEngine memilih predikat paling selektif (hasil search
+    // atau bitmap genre) sebagai titik awal, lalu mengecek sisanya per buku
     QString genre = m_genreCombo->currentText();
     if (genre != "Semua Genre" && !genre.isEmpty()) {
-        std::vector<Book> temp;
-        for (const auto& b : filtered) {
-            if (b.hasGenre(genre)) temp.push_back(b);
-        }
-        filtered = temp;
+        request.query.genres << genre;
     }
     
-    // 3. Sorting menggunakan QuickSort dari struktur data
-    int sortIdx = m_sortCombo->currentIndex();
-    DatabaseManager& dbMgr = DatabaseManager::instance();
-    BookManager& bookMgr = dbMgr.getBookManager();
+    // 3. Rentang tahun/rating: jumlah hasil dihitung O(log n) dari index terurut,
+    // jadi rentang yang sempit otomatis jadi titik awal QueryEngine
+    if (m_minYearSpin->value() != m_minYearSpin->minimum()) request.query.minYear = m_minYearSpin->value();
+    if (m_maxYearSpin->value() != m_maxYearSpin->minimum()) request.query.maxYear = m_maxYearSpin->value();
+    if (m_minRatingSpin->value() > m_minRatingSpin->minimum()) request.query.minRating = m_minRatingSpin->value();
+    
+    // 4. Sorting
+    switch(m_sortCombo->currentIndex()) {
+        case 0: request.sortField = BookManager::SortField::Title;  request.ascending = true;  break; // Judul A-Z
+        case 1: request.sortField = BookManager::SortField::Title;  request.ascending = false; break; // Judul Z-A
+        case 2: request.sortField = BookManager::SortField::Year;   request.ascending = false; break; // Tahun Terbaru (descending)
+        case 3: request.sortField = BookManager::SortField::Year;   request.ascending = true;  break; // Tahun Terlama (ascending)
+        case 4: request.sortField = BookManager::SortField::Rating; request.ascending = false; break; // Rating Tinggi (descending)
+        case 5: request.sortField = BookManager::SortField::Rating; request.ascending = true;  break; // Rating Rendah (ascending)
+        case 6: request.sortField = BookManager::SortField::Author; request.ascending = true;  break; // Penulis A-Z
+        case 7: request.sortField = BookManager::SortField::Author; request.ascending = false; break; // Penulis Z-A
+        default: break;                                                                               // Default: Judul A-Z
+    }
     
-    // Simpan filtered ke temporary BookManager
-    std::vector<Book> originalBooks = bookMgr.getAllBooks();
-    bookMgr.setBooks(filtered);
-    
-    // Apply QuickSort - MENGGUNAKAN IMPLEMENTASI SENDIRI, BUKAN std::sort!
-    switch(sortIdx) {
-        case 0: bookMgr.quickSortByTitle(true); break;   // Judul A-Z
-        case 1: bookMgr.quickSortByTitle(false); break;  // Judul Z-A
-        case 2: bookMgr.quickSortByYear(false); break;   // Tahun Terbaru (descending)
-        case 3: bookMgr.quickSortByYear(true); break;    // Tahun Terlama (ascending)
-        case 4: bookMgr.quickSortByRating(false); break; // Rating Tinggi (descending)
-        case 5: bookMgr.quickSortByRating(true); break;  // Rating Rendah (ascending)
-        case 6: bookMgr.quickSortByAuthor(true); break;  // Penulis A-Z
-        case 7: bookMgr.quickSortByAuthor(false); break; // Penulis Z-A
-        default: bookMgr.quickSortByTitle(true); break;  // Default: Judul A-Z
+    // Generation baru = semua query sebelumnya basi (worker lama berhenti di checkpoint berikutnya)
+    request.generation = ++m_filterShared->generation;
+    std::shared_ptr<FilterShared> shared = m_filterShared;
+    m_filterWatcher.setFuture(QtConcurrent::run([shared, request = std::move(request)]() {
+        return filterAndSort(*shared, request);
+    }));
+}
+
+BooksCollectionPage::FilterResult BooksCollectionPage::filterAndSort(FilterShared& shared,
+                                                                     const FilterRequest& request)
+{
+    // Jalan di worker thread: hanya membaca read view yang immutable, jadi GUI
+    // thread tidak pernah tertahan oleh katalog besar
+    FilterResult result;
+    result.generation = request.generation;
+    result.catalog = request.catalog;
+    auto isStale = [&]() { return shared.generation.load(std::memory_order_relaxed) != request.generation; };
+    const BookManager& catalog = *request.catalog;
+    BookQuery query = request.query;
+    std::vector<int> searchIds;
+    
+    // 1. Search Logic - Sesuai Flowchart: Binary Search untuk title, index untuk partial match
+    if (!request.search.isEmpty()) {
+        // Exact title match: binary search O(log n) di title index (tanpa sort per ketikan)
+        const Book* exact = catalog.findByTitle(request.search);
+        
+        if (exact) {
+            searchIds.push_back(exact->getId());
+        } else {
+            // Partial match (judul atau penulis) lewat trigram index; kalau query
+            // memperpanjang query sebelumnya, cukup saring hasil sebelumnya
+            {
+                QMutexLocker lock(&shared.sessionLock);
+                if (isStale()) return result;
+                searchIds = shared.session.find(catalog, request.search);
+            }
+            
+            // Tidak ada yang cocok -> mungkin salah ketik: coba fuzzy search (edit distance)
+            if (searchIds.empty() && request.search.size() >= kMinFuzzyQueryLength) {
+                if (isStale()) return result;
+                for (const Book& book : catalog.fuzzySearchByTitle(request.search, kFuzzyMaxDistance)) {
+                    searchIds.push_back(book.getId());
+                }
+                Sorting::quickSort(searchIds);
+            }
+        }
+        query.candidateIds = &searchIds;
     }
     
-    // Ambil hasil sorting
-    filtered = bookMgr.getAllBooks();
+    // 2-4. Filter genre/tahun/rating lalu sorting: QuickSort/MergeSort/radix sort sendiri
+    // (lihat BookManager::sortIndices) - MENGGUNAKAN IMPLEMENTASI SENDIRI, BUKAN std::sort!
+    // QueryEngine mengecek isStale di antara tahap filter, sort dan limit
+    if (isStale()) return result;
+    query.ordered = true;
+    query.orderBy = request.sortField;
+    query.ascending = request.ascending;
+    std::vector<uint32_t> filtered = QueryEngine(catalog).run(query, isStale);
+    
+    if (isStale()) return result;
+    result.order.swap(filtered);
+    result.completed = true;
+    return result;
+}
+
+void BooksCollectionPage::onFilterFinished()
+{
+    FilterResult result = m_filterWatcher.result();
     
-    // Restore original books
-    bookMgr.setBooks(originalBooks);
+    // Hasil query lama (sudah ada ketikan/filter baru) atau read view yang sudah diganti -> buang
+    if (!result.completed || result.generation != m_filterShared->generation.load()) return;
+    if (result.catalog != m_catalog) return;
     
-    // 4. Render
+    // 5. Render (harus di GUI thread)
+    const std::vector<Book>& books = m_catalog->books();
     if (m_isCardView) {
-        loadBooksToCards(filtered);
+        loadBooksToCards(books, result.order);
     } else {
-        loadBooksToTable(filtered);
+        loadBooksToTable(books, result.order);
     }
 }
 
 void BooksCollectionPage::loadBooksToTable(const std::vector<Book>& books)
+{
+    std::vector<uint32_t> order(books.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = static_cast<uint32_t>(i);
+    loadBooksToTable(books, order);
+}
+
+void BooksCollectionPage::loadBooksToTable(const std::vector<Book>& books, const std::vector<uint32_t>& order)
 {
     m_tableBooks->setRowCount(0);
     m_tableBooks->setSortingEnabled(false); 
     
-    for (const Book& book : books) {
+    for (uint32_t index : order) {
+        const Book& book = books[index];
         int row = m_tableBooks->rowCount();
         m_tableBooks->insertRow(row);
         m_tableBooks->setRowHeight(row, 60);
@@ -431,6 +537,13 @@ void BooksCollectionPage::loadBooksToTable(const std::vector<Book>& books)
 }
 
 void BooksCollectionPage::loadBooksToCards(const std::vector<Book>& books)
+{
+    std::vector<uint32_t> order(books.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = static_cast<uint32_t>(i);
+    loadBooksToCards(books, order);
+}
+
+void BooksCollectionPage::loadBooksToCards(const std::vector<Book>& books, const std::vector<uint32_t>& order)
 {
     // Clear old cards
     QLayoutItem* item;
@@ -466,8 +579,8 @@ void BooksCollectionPage::loadBooksToCards(const std::vector<Book>& books)
     m_cardLayout->setHorizontalSpacing(spacing);
     m_cardLayout->setAlignment(Qt::AlignTop);
 
-    for (int i = 0; i < books.size(); ++i) {
-        BookCardWidget* card = new BookCardWidget(books[i], m_cardContainer);
+    for (int i = 0; i < static_cast<int>(order.size()); ++i) {
+        BookCardWidget* card = new BookCardWidget(books[order[i]], m_cardContainer);
         
         // Stretch Logic
         card->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
@@ -593,6 +706,9 @@ void BooksCollectionPage::onToggleView()
 void BooksCollectionPage::onClearSearch() { 
     m_searchBox->clear(); 
     m_genreCombo->setCurrentIndex(0); 
+    m_minYearSpin->setValue(m_minYearSpin->minimum());
+    m_maxYearSpin->setValue(m_maxYearSpin->minimum());
+    m_minRatingSpin->setValue(m_minRatingSpin->minimum());
 }
 
 void BooksCollectionPage::onEditBook() { 
@@ -628,5 +744,16 @@ int BooksCollectionPage::getSelectedBookId() {
 }
 
 void BooksCollectionPage::onSearchTextChanged() {
-    onFilterChanged();
+    m_searchDebounce->start();  // Restart timer: hanya ketikan terakhir yang diproses
+}
+
+void BooksCollectionPage::onSearchTextEdited(const QString& text) {
+    // Top-k saran berdasarkan rating, langsung dari prefix trie (tanpa scan katalog)
+    QString prefix = text.trimmed();
+    QStringList suggestions;
+    if (!prefix.isEmpty()) {
+        suggestions = DatabaseManager::instance().getBookManager().completePrefix(prefix, kMaxSearchSuggestions);
+    }
+    m_completionModel->setStringList(suggestions);
+    if (!suggestions.isEmpty()) m_searchCompleter->complete();
 }
\ No newline at end of file
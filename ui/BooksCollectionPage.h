@@ -5,6 +5,8 @@
 #include <QTableWidget>
 #include <QLineEdit>
 #include <QComboBox>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
 #include <QPushButton>
 #include <QScrollArea>
 #include <QGridLayout>
@@ -12,7 +14,16 @@
 #include <QFrame>
 #include <QLabel>
 #include <QResizeEvent>
+#include <QCompleter>
+#include <QStringListModel>
+#include <QTimer>
+#include <QFutureWatcher>
+#include <QMutex>
+#include <atomic>
+#include <memory>
 #include "../backend/DatabaseManager.h"
+#include "../backend/SearchSession.h"
+#include "../backend/QueryEngine.h"
 
 class BooksCollectionPage : public QWidget
 {
@@ -35,7 +46,9 @@ class BooksCollectionPage : public QWidget
 
 private slots:
     void onSearchTextChanged();
+    void onSearchTextEdited(const QString& text);
     void onFilterChanged();
+    void onFilterFinished();
     void onClearSearch();
     void onEditBook();
     void onDeleteBook();
@@ -60,11 +73,39 @@ private slots:
     // Helpers
     QFrame* createCardFrame();
     void loadBooksToTable(const std::vector<Book>& books);
+    void loadBooksToTable(const std::vector<Book>& books, const std::vector<uint32_t>& order);
     void loadBooksToCards(const std::vector<Book>& books);
+    void loadBooksToCards(const std::vector<Book>& books, const std::vector<uint32_t>& order);
     void populateGenreComboBox();
+    void reloadSnapshot();
 
-    // Data Cache
-    std::vector<Book> m_currentBooks; 
+    // Pipeline filter di worker thread
+    struct FilterRequest {
+        quint64 generation = 0;
+        BookManager::ReadView catalog;        // Salinan katalog + index yang immutable, aman dibaca dari thread lain
+        QString search;                       // Teks pencarian (sudah di-trim, kosong = tanpa search)
+        BookQuery query;                      // Filter genre/tahun/rating; hasil search diisi di worker
+        BookManager::SortField sortField = BookManager::SortField::Title;
+        bool ascending = true;
+    };
+    struct FilterResult {
+        quint64 generation = 0;
+        BookManager::ReadView catalog;
+        std::vector<uint32_t> order;          // Posisi ke catalog->books(), sudah difilter dan terurut
+        bool completed = false;               // false = dibatalkan karena query sudah basi
+    };
+    // State yang dipakai worker; lewat shared_ptr supaya worker lama tetap aman setelah halaman dihapus
+    struct FilterShared {
+        std::atomic<quint64> generation{0};   // Generation query terbaru (yang lebih lama = basi)
+        QMutex sessionLock;                   // SearchSession hanya dipakai satu worker pada satu waktu
+        SearchSession session;                // Hasil ketikan sebelumnya, dipersempit per karakter
+    };
+    static FilterResult filterAndSort(FilterShared& shared, const FilterRequest& request);
+
+    // Data Cache (read view BookManager, dibagi dengan halaman lain - bukan salinan sendiri)
+    BookManager::ReadView m_catalog;
+    quint64 m_loadedVersion;              // Versi katalog milik m_catalog (0 = belum ada)
+    std::shared_ptr<FilterShared> m_filterShared;
 
     // UI Elements
     QTableWidget* m_tableBooks;
@@ -78,6 +119,12 @@ private slots:
     QComboBox* m_genreCombo;
     QComboBox* m_sortCombo;
     QLineEdit* m_bstSearchBox; 
+    QSpinBox* m_minYearSpin;              // Nilai minimum = tanpa batas ("Semua")
+    QSpinBox* m_maxYearSpin;
+    QDoubleSpinBox* m_minRatingSpin;
+    static constexpr int kMaxSearchSuggestions = 8;  // Jumlah saran autocomplete
+    QCompleter* m_searchCompleter;        // Saran judul/penulis dari prefix trie BookManager
+    QStringListModel* m_completionModel;
 
     // Buttons
     QPushButton* m_btnEditBook;
@@ -87,6 +134,13 @@ private slots:
     QPushButton* m_btnBuildBST;
 
     bool m_isCardView;
+
+    // Search async: debounce ketikan, generation number untuk membuang hasil basi
+    static constexpr int kSearchDebounceMs = 150;
+    static constexpr int kMinFuzzyQueryLength = 4;        // Query lebih pendek tidak dicoba fuzzy
+    static constexpr int kFuzzyMaxDistance = 2;           // Maksimal salah ketik (edit distance)
+    QTimer* m_searchDebounce;
+    QFutureWatcher<FilterResult> m_filterWatcher;
 };
 
 #endif // BOOKSCOLLECTIONPAGE_H
\ No newline at end of file
@@ -302,7 +302,7 @@ void BorrowQueuePage::refreshQueue()
     
     // Update Combo Box
     m_bookCombo->clear();
-    std::vector<Book> books = bookManager.getAllBooks();
+    const std::vector<Book>& books = bookManager.books();
     for (const Book& book : books) {
         m_bookCombo->addItem(QString("%1 - %2").arg(book.getId()).arg(book.getJudul()), book.getId());
     }
@@ -3,12 +3,11 @@
 #include <QPushButton>
 #include <QScrollArea>
 #include <QHeaderView>
-#include <set>
-#include <map>
 #include <QGraphicsDropShadowEffect> 
 
 DashboardPage::DashboardPage(QWidget *parent)
     : QWidget(parent)
+    , m_renderedVersion(0)
 {
     setupUI();
     // Update data di akhir agar UI siap dulu
@@ -290,28 +289,22 @@ void DashboardPage::createRecentBooksTable(QVBoxLayout* mainLayout)
 void DashboardPage::updateDashboard()
 {
     DatabaseManager& dbManager = DatabaseManager::instance();
-    std::vector<Book> books = dbManager.getAllBooks();
-    
-    // Calculate Stats
-    int totalBooks = books.size();
-    std::set<QString> authors;
-    std::set<QString> genres;
-    double totalRating = 0.0;
-    
-    for (const Book& book : books) {
-        authors.insert(book.getPenulis());
-        for (const QString& genre : book.getGenre()) {
-            genres.insert(genre.trimmed());
-        }
-        totalRating += book.getRating();
-    }
-    double avgRating = totalBooks > 0 ? totalRating / totalBooks : 0.0;
+    BookManager& bookMgr = dbManager.getBookManager();
+    
+    // Katalog tidak berubah sejak update terakhir -> tidak perlu hitung ulang
+    if (bookMgr.getVersion() == m_renderedVersion) return;
+    m_renderedVersion = bookMgr.getVersion();
+    
+    // Statistik diambil dari agregat yang di-update BookManager setiap add/update/delete - O(1)
+    const CatalogStats& stats = bookMgr.getStats();
     
     // Update Labels
-    m_lblTotalBooks->setText(QString::number(totalBooks));
-    m_lblTotalAuthors->setText(QString::number(authors.size()));
-    m_lblTotalGenres->setText(QString::number(genres.size()));
-    m_lblAvgRating->setText(QString::number(avgRating, 'f', 1));
+    m_lblTotalBooks->setText(QString::number(stats.bookCount()));
+    // Mode sketch: jumlah distinct adalah estimasi HyperLogLog, tandai dengan "≈"
+    QString approx = stats.mode() == CatalogStats::Mode::Sketch ? "≈" : "";
+    m_lblTotalAuthors->setText(approx + QString::number(stats.authorCount()));
+    m_lblTotalGenres->setText(approx + QString::number(stats.genreCount()));
+    m_lblAvgRating->setText(QString::number(stats.averageRating(), 'f', 1));
     
     // Update Table Data - MENGGUNAKAN PRIORITY QUEUE (MAX HEAP) UNTUK TOP 5 BOOKS!
     m_recentBooksTable->setRowCount(0);
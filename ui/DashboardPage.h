@@ -45,6 +45,8 @@ class DashboardPage : public QWidget
     QLabel* m_lblAvgRating;
     
     QTableWidget* m_recentBooksTable;
+    
+    quint64 m_renderedVersion;  // Versi katalog yang terakhir ditampilkan (0 = belum pernah)
 };
 
 #endif // DASHBOARDPAGE_H
\ No newline at end of file
@@ -159,7 +159,7 @@ void PopularBooksPage::createContentSection(QVBoxLayout* contentLayout)
     
     m_btnFilterRating = new QPushButton("Filter");
     m_btnFilterRating->setCursor(Qt::PointingHandCursor);
-    m_btnFilterRating->setFixedSize(100, 38);
+    m_btnFilterRating->setFixedSize(120, 38);
     m_btnFilterRating->setStyleSheet("QPushButton { background-color: #FFB547; color: white; border-radius: 8px; font-weight: bold; border: none; } QPushButton:hover { background-color: #E59A2B; }");
 
     controlsLayout->addWidget(lblTopN);
@@ -187,6 +187,8 @@ void PopularBooksPage::createContentSection(QVBoxLayout* contentLayout)
     // Connect Signals
     connect(m_btnShowTopN, &QPushButton::clicked, this, &PopularBooksPage::onShowTopN);
     connect(m_btnFilterRating, &QPushButton::clicked, this, &PopularBooksPage::onFilterByRating);
+    connect(m_minRatingInput, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &PopularBooksPage::onRatingThresholdChanged);
 }
 
 void PopularBooksPage::refreshBooks()
@@ -195,9 +197,11 @@ void PopularBooksPage::refreshBooks()
     DatabaseManager& db = DatabaseManager::instance();
     std::vector<Book> topBooks = db.getBookManager().getTopRatedBooks(10);
     
+    m_ratingFilterActive = false;
     qDebug() << "[PopularBooksPage] Loaded" << topBooks.size() << "books using Max Heap";
     m_resultLabel->setText(QString("🔥 Top %1 Buku dengan Rating Tertinggi (Max Heap)").arg(topBooks.size()));
     displayBooksAsCards(topBooks);
+    onRatingThresholdChanged(m_minRatingInput->value());
 }
 
 void PopularBooksPage::clearGrid()
@@ -250,6 +254,7 @@ void PopularBooksPage::onShowTopN()
     int topN = m_topNInput->value();
     std::vector<Book> topBooks = DatabaseManager::instance().getBookManager().getTopRatedBooks(topN);
     
+    m_ratingFilterActive = false;
     qDebug() << "[PopularBooksPage] Showing top" << topN << "books - Retrieved:" << topBooks.size();
     m_resultLabel->setText(QString("🔥 Top %1 Buku Tertinggi (Max Heap - Priority Queue)").arg(topBooks.size()));
     displayBooksAsCards(topBooks);
@@ -258,9 +263,29 @@ void PopularBooksPage::onShowTopN()
 void PopularBooksPage::onFilterByRating()
 {
     double minRating = m_minRatingInput->value();
-    std::vector<Book> popularBooks = DatabaseManager::instance().getBookManager().getPopularBooks(minRating);
+    const BookManager& bookMgr = DatabaseManager::instance().getBookManager();
     
-    qDebug() << "[PopularBooksPage] Filtered by rating >=" << minRating << "- Found:" << popularBooks.size();
-    m_resultLabel->setText(QString("⭐ Menampilkan %1 buku dengan rating ≥ %2").arg(popularBooks.size()).arg(minRating, 0, 'f', 1));
+    // Hanya halaman pertama yang dirender sebagai kartu; total dari rank di index rating
+    size_t total = bookMgr.countPopularBooks(minRating);
+    std::vector<Book> popularBooks = bookMgr.getPopularBooks(minRating, 0, kMaxRatingCards);
+    m_ratingFilterActive = true;
+    
+    qDebug() << "[PopularBooksPage] Filtered by rating >=" << minRating << "- Found:" << total;
+    if (popularBooks.size() < total) {
+        m_resultLabel->setText(QString("⭐ Menampilkan %1 dari %2 buku dengan rating ≥ %3")
+                                   .arg(popularBooks.size()).arg(total).arg(minRating, 0, 'f', 1));
+    } else {
+        m_resultLabel->setText(QString("⭐ Menampilkan %1 buku dengan rating ≥ %2").arg(total).arg(minRating, 0, 'f', 1));
+    }
     displayBooksAsCards(popularBooks);
+}
+
+void PopularBooksPage::onRatingThresholdChanged(double minRating)
+{
+    // Jumlah buku di atas threshold: satu binary search di index rating, tanpa copy Book
+    const BookManager& bookMgr = DatabaseManager::instance().getBookManager();
+    m_btnFilterRating->setText(QString("Filter (%1)").arg(bookMgr.countPopularBooks(minRating)));
+    
+    // Kalau filter rating sedang tampil, hasilnya ikut berubah langsung (O(log n + k))
+    if (m_ratingFilterActive) onFilterByRating();
 }
\ No newline at end of file
@@ -29,6 +29,7 @@ class PopularBooksPage : public QWidget
 private slots:
     void onShowTopN();
     void onFilterByRating();
+    void onRatingThresholdChanged(double minRating);
 
 private:
     void setupUI();
@@ -49,6 +50,9 @@ private slots:
     QPushButton* m_btnShowTopN;
     QPushButton* m_btnFilterRating;
     QLabel* m_resultLabel;
+    bool m_ratingFilterActive = false;  ///< Grid sedang menampilkan hasil filter rating
+
+    static constexpr size_t kMaxRatingCards = 100;  ///< Batas kartu yang dirender per filter
 };
 
 #endif // POPULARBOOKSPAGE_H
\ No newline at end of file
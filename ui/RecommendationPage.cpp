@@ -20,7 +20,7 @@ RecommendationPage::RecommendationPage(Graph* genreGraph, QWidget *parent)
     // Kecuali ada data baru, tombol manual tetap disediakan.
     QTimer::singleShot(100, this, [this](){
         if(m_genreGraph) {
-            std::vector<Book> allBooks = DatabaseManager::instance().getAllBooks();
+            const std::vector<Book>& allBooks = DatabaseManager::instance().getBookManager().books();
             if (!allBooks.empty()) {
                 m_genreGraph->buildGraph(allBooks);
                 qDebug() << "[RecommendationPage] Auto-built graph with" << allBooks.size() << "books";
@@ -190,7 +190,7 @@ void RecommendationPage::onBuildGraph()
 {
     if (!m_genreGraph) return;
     DatabaseManager& dbManager = DatabaseManager::instance();
-    m_genreGraph->buildGraph(dbManager.getAllBooks());
+    m_genreGraph->buildGraph(dbManager.getBookManager().books());
     QMessageBox::information(this, "Success", "Graph Connectivity berhasil dibangun ulang!");
 }
 
@@ -218,8 +218,8 @@ void RecommendationPage::onGetRecommendations()
     
     // 1. Cari Buku Sumber di Database
     DatabaseManager& dbManager = DatabaseManager::instance();
-    std::vector<Book> allBooks = dbManager.getAllBooks();
-    Book* targetBook = nullptr;
+    const std::vector<Book>& allBooks = dbManager.getBookManager().books();  // View, tanpa copy katalog
+    const Book* targetBook = nullptr;
     int targetBookIndex = -1;
     
     for (size_t i = 0; i < allBooks.size(); i++) {
@@ -7,11 +7,11 @@
 #include <QScrollArea>
 #include <QPainter>
 #include <QGraphicsDropShadowEffect>
-#include <set>
 #include <map>
 
 StatisticsPage::StatisticsPage(QWidget *parent)
     : QWidget(parent)
+    , m_renderedVersion(0)
 {
     setupUI();
     // updateStatistics dipanggil di akhir konstruktor
@@ -217,35 +217,24 @@ QFrame* StatisticsPage::createStatCard(const QString& icon, const QString& title
 void StatisticsPage::updateStatistics()
 {
     DatabaseManager& dbManager = DatabaseManager::instance();
-    std::vector<Book> books = dbManager.getAllBooks();
+    BookManager& bookMgr = dbManager.getBookManager();
     
-    // --- 1. Calculate Data (LOGIKA TIDAK DIUBAH) ---
-    std::map<QString, int> genreCounts;
-    std::map<int, int> ratingCounts; 
-    std::map<int, int> yearCounts;
+    // Katalog tidak berubah sejak update terakhir -> grafik masih valid
+    if (bookMgr.getVersion() == m_renderedVersion) return;
+    m_renderedVersion = bookMgr.getVersion();
     
-    double totalRatingSum = 0;
-    
-    for (const Book& book : books) {
-        for (const QString& genre : book.getGenre()) {
-            genreCounts[genre.trimmed()]++;
-        }
-        
-        int ratingGroup = static_cast<int>(book.getRating());
-        ratingCounts[ratingGroup]++;
-        
-        int decade = (book.getTahun() / 10) * 10;
-        yearCounts[decade]++;
-        
-        totalRatingSum += book.getRating();
-    }
+    // --- 1. Data dari agregat BookManager (di-update setiap add/update/delete, tanpa scan katalog) ---
+    const CatalogStats& stats = bookMgr.getStats();
+    const std::map<QString, int>& genreCounts = stats.genreCounts();
+    const std::map<int, int>& yearCounts = stats.decadeHistogram();
+    size_t totalBooks = stats.bookCount();
     
     // Update Summary Cards
-    if (m_lblTotalBooks) m_lblTotalBooks->setText(QString::number(books.size()));
-    if (m_lblTotalGenres) m_lblTotalGenres->setText(QString::number(genreCounts.size()));
-    
-    double avg = books.empty() ? 0.0 : (totalRatingSum / books.size());
-    if (m_lblAvgRating) m_lblAvgRating->setText(QString::number(avg, 'f', 1));
+    if (m_lblTotalBooks) m_lblTotalBooks->setText(QString::number(totalBooks));
+    // Mode sketch: jumlah genre dan hitungan per genre adalah estimasi
+    QString approx = stats.mode() == CatalogStats::Mode::Sketch ? "≈" : "";
+    if (m_lblTotalGenres) m_lblTotalGenres->setText(approx + QString::number(stats.genreCount()));
+    if (m_lblAvgRating) m_lblAvgRating->setText(QString::number(stats.averageRating(), 'f', 1));
     
     // --- 2. Update Charts (VISUAL HTML DIPERBAIKI) ---
     
@@ -261,7 +250,7 @@ void StatisticsPage::updateStatistics()
     int count = 0;
     for (const auto& [genre, cnt] : genreVec) {
         if (count++ >= 8) break; // Limit 8 items
-        int percentage = books.empty() ? 0 : (cnt * 100 / books.size());
+        int percentage = totalBooks == 0 ? 0 : static_cast<int>(cnt * 100 / totalBooks);
         
         // Bar visual sederhana menggunakan karakter block █ atau warna background
         // Di sini kita gunakan teks rapi + persentase bold
@@ -269,9 +258,9 @@ void StatisticsPage::updateStatistics()
             "<tr>"
             "  <td width='60%' style='font-size: 14px;'>%1</td>"
             "  <td width='20%' style='font-size: 14px; font-weight: bold; color: #4318FF;'>%2%</td>"
-            "  <td width='20%' style='font-size: 13px; color: #A3AED0; text-align: right;'>%3 buku</td>"
+            "  <td width='20%' style='font-size: 13px; color: #A3AED0; text-align: right;'>%3%4 buku</td>"
             "</tr>"
-        ).arg(genre).arg(percentage).arg(cnt);
+        ).arg(genre).arg(percentage).arg(approx).arg(cnt);
     }
     genreHtml += "</table></body></html>";
     
@@ -288,8 +277,8 @@ void StatisticsPage::updateStatistics()
     ratingHtml += "<table width='100%' cellspacing='0' cellpadding='4'>";
     
     for (int i = 5; i >= 1; i--) {
-        int cnt = ratingCounts[i];
-        int percentage = books.empty() ? 0 : (cnt * 100 / books.size());
+        int cnt = stats.ratingBucketCount(i);
+        int percentage = totalBooks == 0 ? 0 : static_cast<int>(cnt * 100 / totalBooks);
         QString stars = QString("⭐").repeated(i);
         
         ratingHtml += QString(
@@ -37,6 +37,8 @@ class StatisticsPage : public QWidget
     QLabel* m_lblTotalBooks;
     QLabel* m_lblTotalGenres;
     QLabel* m_lblAvgRating;
+    
+    quint64 m_renderedVersion;  // Versi katalog yang terakhir ditampilkan (0 = belum pernah)
 };
 
 #endif // STATISTICSPAGE_H
\ No newline at end of file
@@ -36,7 +36,8 @@ MainWindow::MainWindow(QWidget *parent)
     }
     
     // Check if database is empty, insert sample books
-    std::vector<Book> existingBooks = dbManager.getAllBooks();
+    // (view ke BookManager - import/insert di bawah langsung terlihat di sini, tanpa query ulang)
+    const std::vector<Book>& existingBooks = dbManager.getBookManager().books();
     if (existingBooks.empty()) {
         // Try to import from JSON first
         m_currentDataPath = QCoreApplication::applicationDirPath() + "/../data/books.json";
@@ -46,23 +47,16 @@ MainWindow::MainWindow(QWidget *parent)
             m_currentDataPath = "data/books.json";
         }
         
-        bool dataLoaded = false;
         if (dbManager.importFromJson(m_currentDataPath)) {
             updateStatusBar("📚 Imported data from JSON to database");
-            dataLoaded = true;
         } else {
             // Insert sample books if JSON import failed
             if (dbManager.insertSampleBooks()) {
                 updateStatusBar("📚 Inserted 15 sample books to database");
-                dataLoaded = true;
             } else {
                 updateStatusBar("⚠ No data loaded. Use File menu to import books.");
             }
         }
-        
-        if (dataLoaded) {
-            existingBooks = dbManager.getAllBooks();
-        }
     }
     
     // === AUTO-INITIALIZE DATA STRUCTURES ===
@@ -355,8 +349,7 @@ void MainWindow::createPages()
                         m_collectionPage->refreshTable();
                         m_dashboardPage->updateDashboard();
                         m_statisticsPage->updateStatistics();
-                        std::vector<Book> books = dbManager.getAllBooks();
-                        m_genreGraph.buildGraph(books);
+                        m_genreGraph.buildGraph(dbManager.getBookManager().books());
                         showSuccessMessage("✅ Berhasil", 
                                          QString("Buku '%1' berhasil diperbarui!").arg(updatedBook.getJudul()));
                     }
@@ -383,8 +376,7 @@ void MainWindow::createPages()
                         m_collectionPage->refreshTable();
                         m_dashboardPage->updateDashboard();
                         m_statisticsPage->updateStatistics();
-                        std::vector<Book> books = dbManager.getAllBooks();
-                        m_genreGraph.buildGraph(books);
+                        m_genreGraph.buildGraph(dbManager.getBookManager().books());
                         showSuccessMessage("✅ Berhasil", QString("Buku '%1' berhasil dihapus!").arg(bookTitle));
                     }
                 }
@@ -398,8 +390,7 @@ void MainWindow::createPages()
         m_collectionPage->refreshTable();
         m_dashboardPage->updateDashboard();
         m_statisticsPage->updateStatistics();
-        std::vector<Book> books = dbManager.getAllBooks();
-        m_genreGraph.buildGraph(books);
+        m_genreGraph.buildGraph(dbManager.getBookManager().books());
     });
     m_stackedWidget->addWidget(m_addBookPage);
     
@@ -494,7 +485,7 @@ void MainWindow::onLoadData()
     DatabaseManager& dbManager = DatabaseManager::instance();
     if (dbManager.importFromJson(fileName)) {
         m_currentDataPath = fileName;
-        std::vector<Book> books = dbManager.getAllBooks();
+        const std::vector<Book>& books = dbManager.getBookManager().books();
         
         // Rebuild all data structures after import
         qDebug() << "[MainWindow] Rebuilding data structures after import...";
@@ -532,12 +523,12 @@ void MainWindow::onSaveData()
         return;
     
     DatabaseManager& dbManager = DatabaseManager::instance();
-    std::vector<Book> books = dbManager.getAllBooks();
+    size_t bookCount = dbManager.getBookManager().getBookCount();
     
     if (dbManager.exportToJson(fileName)) {
         m_currentDataPath = fileName;
         updateStatusBar(QString("Exported %1 books to %2")
-                       .arg(books.size())
+                       .arg(bookCount)
                        .arg(QFileInfo(fileName).fileName()));
         showSuccessMessage("Success", "Data exported successfully!");
     } else {
@@ -548,7 +539,10 @@ void MainWindow::onSaveData()
 void MainWindow::onRefreshData()
 {
     DatabaseManager& dbManager = DatabaseManager::instance();
-    std::vector<Book> allBooks = dbManager.getAllBooks();
+    
+    // Refresh = baca ulang SQLite ke BookManager (versi katalog naik, halaman ikut update)
+    dbManager.syncBookManager();
+    const std::vector<Book>& allBooks = dbManager.getBookManager().books();
     
     if (!allBooks.empty()) {
         // Rebuild all data structures